@@ -21,6 +21,7 @@
 #include "hal_i2c.h"
 #include "pmbus.h"
 #include "adm1272.h"
+#include "sensor_energy.h"
 #include <sys/util.h>
 
 LOG_MODULE_REGISTER(dev_adm1272);
@@ -297,9 +298,8 @@ static int adm1272_read_ein(sensor_cfg *cfg, float *val)
 	I2C_MSG msg = { 0 };
 
 	uint32_t energy = 0, rollover = 0, sample = 0;
-	uint32_t pre_energy = 0, pre_rollover = 0, pre_sample = 0;
 	uint32_t sample_diff = 0;
-	double energy_diff = 0;
+	uint64_t energy_diff = 0;
 
 	/* Read EIN */
 	msg.bus = cfg->port;
@@ -314,57 +314,26 @@ static int adm1272_read_ein(sensor_cfg *cfg, float *val)
 		return -1;
 	}
 
-	/* Record the previous and current data */
-#ifdef MORE_THAN_ONE_ADM1272
-	pre_energy = init_arg->last_energy;
-	pre_rollover = init_arg->last_rollover;
-	pre_sample = init_arg->last_sample;
+	energy = (msg.data[2] << 8) | msg.data[1];
+	rollover = msg.data[3];
+	sample = (msg.data[6] << 16) | (msg.data[5] << 8) | msg.data[4];
 
-	init_arg->last_energy = energy = (msg.data[2] << 8) | msg.data[1];
-	init_arg->last_rollover = rollover = msg.data[3];
-	init_arg->last_sample = sample = (msg.data[6] << 16) | (msg.data[5] << 8) | msg.data[4];
-
-	SET_FLAG_WITH_RETURN(init_arg->is_record_ein, true, -1);
-#else
-	static bool is_record_ein = false;
-	static uint32_t last_energy = 0, last_rollover = 0, last_sample = 0;
-
-	pre_energy = last_energy;
-	pre_rollover = last_rollover;
-	pre_sample = last_sample;
-
-	last_energy = energy = (msg.data[2] << 8) | msg.data[1];
-	last_rollover = rollover = msg.data[3];
-	last_sample = sample = (msg.data[6] << 16) | (msg.data[5] << 8) | msg.data[4];
-
-	SET_FLAG_WITH_RETURN(is_record_ein, true, -1);
-#endif
-
-	if ((pre_rollover > rollover) || ((pre_rollover == rollover) && (pre_energy > energy))) {
-		rollover += ADM1272_EIN_ROLLOVER_CNT_MAX;
-	}
-
-	if (pre_sample > sample) {
-		sample += ADM1272_EIN_SAMPLE_CNT_MAX;
-	}
-
-	energy_diff = (double)(rollover - pre_rollover) * ADM1272_EIN_ENERGY_CNT_MAX +
-		      (double)energy - (double)pre_energy;
-	if (energy_diff < 0) {
-		LOG_DBG("Energy difference is less than zero.");
+	/* The accumulator keeps the previous counters per sensor and handles the wrap */
+	if (sensor_energy_update_counter(
+		    cfg, ((uint64_t)rollover * ADM1272_EIN_ENERGY_CNT_MAX) + energy,
+		    (uint64_t)ADM1272_EIN_ROLLOVER_CNT_MAX * ADM1272_EIN_ENERGY_CNT_MAX, sample,
+		    ADM1272_EIN_SAMPLE_CNT_MAX, &energy_diff, &sample_diff) != 0) {
 		return -1;
 	}
 
-	sample_diff = sample - pre_sample;
-	if (sample_diff == 0) {
-		LOG_DBG("Sample difference is less than zero.");
-		return -1;
+	*val = (double)energy_diff / sample_diff;
+	ret = adm1272_convert_real_value(init_arg->pwr_monitor_cfg.fields.VRANGE,
+					 init_arg->pwr_monitor_cfg.fields.IRANGE,
+					 init_arg->r_sense_mohm, PMBUS_READ_PIN, val);
+	if (ret == 0) {
+		sensor_energy_accumulate(cfg, *val);
 	}
-
-	*val = (double)(energy_diff / sample_diff);
-	return adm1272_convert_real_value(init_arg->pwr_monitor_cfg.fields.VRANGE,
-					  init_arg->pwr_monitor_cfg.fields.IRANGE,
-					  init_arg->r_sense_mohm, PMBUS_READ_PIN, val);
+	return ret;
 }
 
 uint8_t adm1272_read(sensor_cfg *cfg, int *reading)
@@ -17,6 +17,7 @@
 #include "hal_i2c.h"
 #include "pmbus.h"
 #include "sensor.h"
+#include "sensor_energy.h"
 #include <logging/log.h>
 #include <stdio.h>
 #include <string.h>
@@ -41,11 +42,8 @@ int adm1278_read_ein_ext(float rsense, float *val, sensor_cfg *cfg)
 	I2C_MSG msg;
 	uint8_t retry = 5;
 	uint32_t energy = 0, rollover = 0, sample = 0;
-	uint32_t pre_energy = 0, pre_rollover = 0, pre_sample = 0;
 	uint32_t sample_diff = 0;
-	double energy_diff = 0;
-	static uint32_t last_energy = 0, last_rollover = 0, last_sample = 0;
-	static bool pre_ein = false;
+	uint64_t energy_diff = 0;
 
 	msg.bus = cfg->port;
 	msg.target_addr = cfg->target_addr;
@@ -58,44 +56,20 @@ int adm1278_read_ein_ext(float rsense, float *val, sensor_cfg *cfg)
 		return SENSOR_FAIL_TO_ACCESS;
 	}
 
-	//record the previous data
-	pre_energy = last_energy;
-	pre_rollover = last_rollover;
-	pre_sample = last_sample;
+	energy = (msg.data[2] << 16) | (msg.data[1] << 8) | msg.data[0];
+	rollover = (msg.data[4] << 8) | msg.data[3];
+	sample = (msg.data[7] << 16) | (msg.data[6] << 8) | msg.data[5];
 
-	//record the current data
-	last_energy = energy = (msg.data[2] << 16) | (msg.data[1] << 8) | msg.data[0];
-	last_rollover = rollover = (msg.data[4] << 8) | msg.data[3];
-	last_sample = sample = (msg.data[7] << 16) | (msg.data[6] << 8) | msg.data[5];
-
-	//return since data isn't enough
-	if (pre_ein == false) {
-		pre_ein = true;
-		return -1;
-	}
-
-	if ((pre_rollover > rollover) || ((pre_rollover == rollover) && (pre_energy > energy))) {
-		rollover += ADM1278_EIN_ROLLOVER_CNT_MAX;
-	}
-
-	if (pre_sample > sample) {
-		sample += ADM1278_EIN_SAMPLE_CNT_MAX;
-	}
-
-	energy_diff = (double)(rollover - pre_rollover) * ADM1278_EIN_ENERGY_CNT_MAX +
-		      (double)energy - (double)pre_energy;
-	if (energy_diff < 0) {
-		LOG_DBG("Energy difference is less than zero.");
-		return -1;
-	}
-
-	sample_diff = sample - pre_sample;
-	if (sample_diff == 0) {
-		LOG_DBG("Sample difference is less than zero.");
+	/* The accumulator keeps the previous counters per sensor and handles the wrap */
+	if (sensor_energy_update_counter(
+		    cfg, ((uint64_t)rollover * ADM1278_EIN_ENERGY_CNT_MAX) + energy,
+		    (uint64_t)ADM1278_EIN_ROLLOVER_CNT_MAX * ADM1278_EIN_ENERGY_CNT_MAX, sample,
+		    ADM1278_EIN_SAMPLE_CNT_MAX, &energy_diff, &sample_diff) != 0) {
 		return -1;
 	}
 
-	*val = (float)((energy_diff / sample_diff / 256) * 100) / (6123 * rsense);
+	*val = (float)(((double)energy_diff / sample_diff / 256) * 100) / (6123 * rsense);
+	sensor_energy_accumulate(cfg, *val);
 
 	return 0;
 }
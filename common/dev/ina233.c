@@ -19,6 +19,7 @@
 #include <string.h>
 #include <logging/log.h>
 #include "sensor.h"
+#include "sensor_energy.h"
 #include "pmbus.h"
 #include "hal_i2c.h"
 #include "ina233.h"
@@ -189,6 +190,9 @@ uint8_t ina233_read(sensor_cfg *cfg, int *reading)
 
 	sval->integer = val / parameter;
 	sval->fraction = ((val / parameter) - sval->integer) * 1000;
+	if (offset == PMBUS_READ_EIN) {
+		sensor_energy_accumulate(cfg, val / parameter);
+	}
 	return SENSOR_READ_SUCCESS;
 }
 
@@ -28,6 +28,12 @@
 
 #define PECI_CC_SUCCESS 0x40
 
+/* RdPkgConfig response cache, see intel_peci_rdpkg_read_cached */
+#define PECI_RDPKG_CACHE_SIZE_DEFAULT 24
+#define PECI_RDPKG_CACHE_WINDOW_MS_DEFAULT 200
+#define PECI_RDPKG_CACHE_DATA_LEN 5
+#define PECI_RDPKG_CACHE_NO_EXPIRE (-1)
+
 enum {
 	PECI_UNKNOWN = 0x00,
 	PECI_TEMP_CPU_MARGIN,
@@ -60,6 +66,9 @@ typedef struct {
 	uint8_t power_unit;
 } intel_peci_unit;
 
+int intel_peci_rdpkg_read_cached(uint8_t addr, uint8_t index, uint16_t param, uint8_t rlen,
+				 uint8_t *rbuf, int64_t valid_ms);
+void intel_peci_cache_invalidate(uint8_t addr);
 bool check_dimm_present(uint8_t dimm_channel, uint8_t dimm_num, uint8_t *present_result);
 bool pal_get_power_sku_unit(uint8_t addr);
 bool pal_get_cpu_time(uint8_t addr, uint8_t cmd, uint8_t readlen, uint32_t *run_time);
@@ -22,6 +22,11 @@
 #define PCC_STACK_SIZE 512
 #define PCC_BUFFER_LEN 1024
 #define PROCESS_POSTCODE_STACK_SIZE 2048
+/* Codes per message to the BMC, platforms whose BMC parses a code list raise it */
+#define PCC_POSTCODE_BATCH_MAX_DEFAULT 1
+#define PCC_POSTCODE_MAX_INFLIGHT_DEFAULT 4
+/* Resends of a timed out batch, platforms setting PLDM_MSG_MAX_RETRY use that instead */
+#define PCC_POSTCODE_MAX_RETRY_DEFAULT 3
 
 uint16_t copy_pcc_read_buffer(uint16_t start, uint16_t length, uint8_t *buffer,
 			      uint16_t buffer_len);
@@ -29,6 +34,7 @@ void pcc_init();
 void reset_pcc_buffer();
 bool get_4byte_postcode_ok();
 void reset_4byte_postcode_ok();
+uint32_t get_pcc_postcode_overrun_count();
 
 void pcc_platform_filter_init(void);
 bool pcc_platform_filter_postcode(uint32_t postcode);
@@ -36,6 +36,8 @@ enum pmbus_regs {
 	PMBUS_PAGE_PLUS_READ = 0x06,
 
 	PMBUS_WRITE_PROTECT = 0x10,
+	PMBUS_RESTORE_DEFAULT_ALL = 0x12,
+	PMBUS_RESTORE_USER_ALL = 0x16,
 
 	PMBUS_CAPABILITY = 0x19,
 	PMBUS_QUERY = 0x1A,
@@ -22,6 +22,9 @@
 #define SENDPOSTCODE_STACK_SIZE 2048
 #define SNOOP_STACK_SIZE 512
 #define SNOOP_MAX_LEN 244
+/* Interrupt side byte ring, must be a power of two */
+#define SNOOP_RING_SIZE_DEFAULT 512
+#define SNOOP_READ_SPAN_LEN 32
 
 enum POSTCODE_COPY_TYPES {
 	COPY_ALL_POSTCODE,
@@ -29,6 +32,8 @@ enum POSTCODE_COPY_TYPES {
 };
 
 extern int snoop_read_num;
+int snoop_ring_read(uint32_t ch, uint8_t *out, uint16_t len, bool blocking);
+uint32_t get_snoop_overwrite_count(uint32_t ch);
 void copy_snoop_read_buffer(uint8_t offset, int size_num, uint8_t *buffer, uint8_t copy_mode);
 bool get_postcode_ok();
 void reset_postcode_ok();
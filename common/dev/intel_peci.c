@@ -19,12 +19,14 @@
 #include <string.h>
 #include <drivers/peci.h>
 #include "sensor.h"
+#include "sensor_energy.h"
 #include "hal_peci.h"
 #include "libutil.h"
 #include "intel_peci.h"
 #include "ipmi.h"
 #include "util_sys.h"
 #include "intel_dimm.h"
+#include "power_status.h"
 #include <logging/log.h>
 #include "time.h"
 
@@ -33,16 +35,134 @@ LOG_MODULE_REGISTER(dev_intel_peci);
 #define DIMM_TEMP_OFS_0 0x01
 #define DIMM_TEMP_OFS_1 0x02
 
+#ifndef PECI_RDPKG_CACHE_SIZE
+#define PECI_RDPKG_CACHE_SIZE PECI_RDPKG_CACHE_SIZE_DEFAULT
+#endif
+
+#ifndef PECI_RDPKG_CACHE_WINDOW_MS
+#define PECI_RDPKG_CACHE_WINDOW_MS PECI_RDPKG_CACHE_WINDOW_MS_DEFAULT
+#endif
+
+typedef struct _peci_rdpkg_cache_entry {
+	uint8_t addr;
+	uint8_t index;
+	uint16_t param;
+	uint8_t data[PECI_RDPKG_CACHE_DATA_LEN];
+	uint32_t cpu_power_change_count;
+	int64_t expire_ms;
+	bool valid;
+} peci_rdpkg_cache_entry;
+
 static intel_peci_unit unit_info;
 
-__weak bool pal_get_power_sku_unit(uint8_t addr)
+/* RdPkgConfig responses shared by sensors reading the same index and parameter */
+static peci_rdpkg_cache_entry peci_rdpkg_cache[PECI_RDPKG_CACHE_SIZE];
+static uint8_t peci_rdpkg_cache_victim = 0;
+static struct k_spinlock peci_rdpkg_cache_lock;
+
+static peci_rdpkg_cache_entry *peci_rdpkg_cache_find(uint8_t addr, uint8_t index, uint16_t param)
+{
+	for (int i = 0; i < PECI_RDPKG_CACHE_SIZE; i++) {
+		peci_rdpkg_cache_entry *entry = &peci_rdpkg_cache[i];
+		if (entry->valid && (entry->addr == addr) && (entry->index == index) &&
+		    (entry->param == param)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static bool peci_rdpkg_cache_lookup(uint8_t addr, uint8_t index, uint16_t param, uint8_t rlen,
+				    uint8_t *rbuf)
 {
-	static int is_read_before;
+	bool hit = false;
+	k_spinlock_key_t key = k_spin_lock(&peci_rdpkg_cache_lock);
+
+	peci_rdpkg_cache_entry *entry = peci_rdpkg_cache_find(addr, index, param);
+	if (entry != NULL) {
+		// Values read before the last CPU power change belong to the previous boot
+		if ((entry->cpu_power_change_count != get_CPU_power_change_count()) ||
+		    ((entry->expire_ms != PECI_RDPKG_CACHE_NO_EXPIRE) &&
+		     (k_uptime_get() >= entry->expire_ms))) {
+			entry->valid = false;
+		} else {
+			memcpy(rbuf, entry->data, rlen);
+			hit = true;
+		}
+	}
 
-	if (is_read_before)
-		return true;
+	k_spin_unlock(&peci_rdpkg_cache_lock, key);
+	return hit;
+}
 
-	uint8_t command = PECI_RD_PKG_CFG0_CMD;
+static void peci_rdpkg_cache_store(uint8_t addr, uint8_t index, uint16_t param, uint8_t rlen,
+				   const uint8_t *rbuf, int64_t valid_ms)
+{
+	k_spinlock_key_t key = k_spin_lock(&peci_rdpkg_cache_lock);
+
+	peci_rdpkg_cache_entry *entry = peci_rdpkg_cache_find(addr, index, param);
+	if (entry == NULL) {
+		// Reuse entries round robin once the table is full
+		entry = &peci_rdpkg_cache[peci_rdpkg_cache_victim];
+		peci_rdpkg_cache_victim = (peci_rdpkg_cache_victim + 1) % PECI_RDPKG_CACHE_SIZE;
+	}
+
+	entry->addr = addr;
+	entry->index = index;
+	entry->param = param;
+	memcpy(entry->data, rbuf, rlen);
+	entry->cpu_power_change_count = get_CPU_power_change_count();
+	entry->expire_ms = (valid_ms == PECI_RDPKG_CACHE_NO_EXPIRE) ? PECI_RDPKG_CACHE_NO_EXPIRE :
+								      (k_uptime_get() + valid_ms);
+	entry->valid = true;
+
+	k_spin_unlock(&peci_rdpkg_cache_lock, key);
+}
+
+void intel_peci_cache_invalidate(uint8_t addr)
+{
+	k_spinlock_key_t key = k_spin_lock(&peci_rdpkg_cache_lock);
+
+	for (int i = 0; i < PECI_RDPKG_CACHE_SIZE; i++) {
+		if (peci_rdpkg_cache[i].addr == addr) {
+			peci_rdpkg_cache[i].valid = false;
+		}
+	}
+
+	k_spin_unlock(&peci_rdpkg_cache_lock, key);
+}
+
+/* RdPkgConfig served from the cache when a response younger than valid_ms exists.
+ * Only completed transactions (cc 0x40) are stored, so retries still reach the CPU.
+ */
+int intel_peci_rdpkg_read_cached(uint8_t addr, uint8_t index, uint16_t param, uint8_t rlen,
+				 uint8_t *rbuf, int64_t valid_ms)
+{
+	CHECK_NULL_ARG_WITH_RETURN(rbuf, -1);
+
+	if ((rlen > PECI_RDPKG_CACHE_DATA_LEN) || (valid_ms == 0)) {
+		return peci_read(PECI_CMD_RD_PKG_CFG0, addr, index, param, rlen, rbuf);
+	}
+
+	if (peci_rdpkg_cache_lookup(addr, index, param, rlen, rbuf)) {
+		return 0;
+	}
+
+	int ret = peci_read(PECI_CMD_RD_PKG_CFG0, addr, index, param, rlen, rbuf);
+	if (ret != 0) {
+		intel_peci_cache_invalidate(addr);
+		return ret;
+	}
+
+	if (rbuf[0] == PECI_CC_RSP_SUCCESS) {
+		peci_rdpkg_cache_store(addr, index, param, rlen, rbuf, valid_ms);
+	}
+	return ret;
+}
+
+__weak bool pal_get_power_sku_unit(uint8_t addr)
+{
 	uint8_t readlen = 0x05;
 
 	int ret = 0;
@@ -51,7 +171,9 @@ __weak bool pal_get_power_sku_unit(uint8_t addr)
 		LOG_ERR("%s fail to allocate readbuf memory", __func__);
 		return false;
 	}
-	ret = peci_read(command, addr, RDPKG_IDX_PWR_SKU_UNIT_READ, 0, readlen, readbuf);
+	// Fixed for the CPU SKU, read once per CPU power on
+	ret = intel_peci_rdpkg_read_cached(addr, RDPKG_IDX_PWR_SKU_UNIT_READ, 0, readlen, readbuf,
+					   PECI_RDPKG_CACHE_NO_EXPIRE);
 	if (ret) {
 		LOG_ERR("%s peci read error", __func__);
 		goto cleanup;
@@ -73,8 +195,6 @@ __weak bool pal_get_power_sku_unit(uint8_t addr)
 	unit_info.energy_unit = (pwr_sku_unit >> 8) & 0x1F;
 	unit_info.power_unit = pwr_sku_unit & 0xF;
 
-	is_read_before = 1;
-
 	SAFE_FREE(readbuf);
 	return true;
 cleanup:
@@ -275,13 +395,13 @@ __weak void pal_cal_cpu_power(intel_peci_unit unit_info, uint32_t diff_energy, u
 	*reading = ((float)diff_energy / (float)diff_time) * pwr_scale;
 }
 
-bool read_cpu_power(uint8_t addr, int *reading)
+bool read_cpu_power(sensor_cfg *cfg, uint8_t addr, int *reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(reading, false);
 
 	bool ret = true;
-	uint32_t pkg_energy, run_time, diff_energy, diff_time;
-	static uint32_t last_pkg_energy = 0, last_run_time = 0;
+	uint32_t pkg_energy, run_time, diff_time;
+	uint64_t diff_energy;
 
 	ret = pal_get_cpu_energy(addr, &pkg_energy, &run_time);
 	if (!ret) {
@@ -294,34 +414,15 @@ bool read_cpu_power(uint8_t addr, int *reading)
 		return false;
 	}
 
-	if (last_pkg_energy == 0 &&
-	    last_run_time == 0) { // first read, need second data to calculate
-		last_pkg_energy = pkg_energy;
-		last_run_time = run_time;
-		LOG_DBG("CPU power first read");
+	// First read or no time elapsed, need another snapshot to calculate
+	if (sensor_energy_update_counter(cfg, pkg_energy, SENSOR_ENERGY_WRAP_32BIT, run_time, 0,
+					 &diff_energy, &diff_time) != 0) {
+		LOG_DBG("CPU power needs another energy snapshot");
 		return false;
 	}
 
-	if (pkg_energy >= last_pkg_energy) {
-		diff_energy = pkg_energy - last_pkg_energy;
-	} else {
-		diff_energy = pkg_energy + (0xffffffff - last_pkg_energy + 1);
-	}
-	last_pkg_energy = pkg_energy;
-
-	if (run_time >= last_run_time) {
-		diff_time = run_time - last_run_time;
-	} else {
-		diff_time = run_time + (0xffffffff - last_run_time + 1);
-	}
-	last_run_time = run_time;
-
-	if (diff_time == 0) {
-		LOG_DBG("CPU power time elapsed is zero");
-		return false;
-	}
-
-	pal_cal_cpu_power(unit_info, diff_energy, diff_time, reading);
+	pal_cal_cpu_power(unit_info, (uint32_t)diff_energy, diff_time, reading);
+	sensor_energy_accumulate(cfg, *reading);
 
 	return true;
 }
@@ -384,13 +485,13 @@ __weak void pal_cal_total_dimm_power(intel_peci_unit unit_info, uint32_t diff_en
 	*reading = ((float)diff_energy / (float)diff_time) * pwr_scale;
 }
 
-bool read_total_dimm_power(uint8_t addr, int *reading)
+bool read_total_dimm_power(sensor_cfg *cfg, uint8_t addr, int *reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(reading, false);
 
 	bool ret = true;
-	uint32_t pkg_energy, diff_energy, run_time, diff_time;
-	static uint32_t last_pkg_energy = 0, last_run_time = 0;
+	uint32_t pkg_energy, run_time, diff_time;
+	uint64_t diff_energy;
 
 	ret = pal_get_dimm_energy(addr, &pkg_energy);
 
@@ -401,31 +502,16 @@ bool read_total_dimm_power(uint8_t addr, int *reading)
 		return false;
 	}
 
-	if (last_pkg_energy == 0 &&
-	    last_run_time == 0) { // first read, need second data to calculate
-		last_pkg_energy = pkg_energy;
-		last_run_time = run_time;
-		LOG_DBG("Total DIMM power first read");
-		return false;
-	}
-
-	if (pkg_energy >= last_pkg_energy) {
-		diff_energy = pkg_energy - last_pkg_energy;
-	} else {
-		diff_energy = pkg_energy + (0xffffffff - last_pkg_energy + 1);
-	}
-	last_pkg_energy = pkg_energy;
-
-	diff_time = run_time - last_run_time;
-	last_run_time = run_time;
-
-	if (diff_time == 0) {
-		LOG_DBG("Total DIMM power time elapsed is zero");
+	// First read or no time elapsed, need another snapshot to calculate
+	if (sensor_energy_update_counter(cfg, pkg_energy, SENSOR_ENERGY_WRAP_32BIT, run_time, 0,
+					 &diff_energy, &diff_time) != 0) {
+		LOG_DBG("Total DIMM power needs another energy snapshot");
 		return false;
 	}
 
 	diff_energy *= 1000;
-	pal_cal_total_dimm_power(unit_info, diff_energy, diff_time, reading);
+	pal_cal_total_dimm_power(unit_info, (uint32_t)diff_energy, diff_time, reading);
+	sensor_energy_accumulate(cfg, *reading);
 
 	return true;
 }
@@ -442,7 +528,9 @@ static bool get_cpu_tjmax(uint8_t addr, int *reading)
 	uint8_t rbuf[rlen];
 	memset(rbuf, 0, sizeof(rbuf));
 
-	int ret = peci_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_TJMAX_TEMP, param, rlen, rbuf);
+	// TjMax is fixed for the CPU, read once per CPU power on
+	int ret = intel_peci_rdpkg_read_cached(addr, RDPKG_IDX_TJMAX_TEMP, param, rlen, rbuf,
+					       PECI_RDPKG_CACHE_NO_EXPIRE);
 	if (ret != 0) {
 		LOG_DBG("PECI read error");
 		return false;
@@ -467,8 +555,9 @@ static bool get_cpu_margin(uint8_t addr, int *reading)
 	memset(rbuf, 0, sizeof(rbuf));
 
 	for (i = 0; i < retry; i++) {
-		int ret = peci_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_PKG_TEMP, param, rlen,
-				    rbuf);
+		// Shared by the CPU margin and CPU temperature sensors of one sweep
+		int ret = intel_peci_rdpkg_read_cached(addr, RDPKG_IDX_PKG_TEMP, param, rlen, rbuf,
+						       PECI_RDPKG_CACHE_WINDOW_MS);
 		if (ret != 0) {
 			LOG_ERR("PECI read error");
 			return false;
@@ -498,7 +587,7 @@ static bool get_cpu_margin(uint8_t addr, int *reading)
 	return true;
 }
 
-static bool get_cpu_pwr(uint8_t addr, int *reading)
+static bool get_cpu_pwr(sensor_cfg *cfg, int *reading)
 {
 	if (!reading) {
 		LOG_ERR("Invalid argument");
@@ -506,7 +595,7 @@ static bool get_cpu_pwr(uint8_t addr, int *reading)
 	}
 
 	int pwr = 0;
-	if (read_cpu_power(addr, &pwr) == false) {
+	if (read_cpu_power(cfg, cfg->target_addr, &pwr) == false) {
 		LOG_ERR("Read CPU power error");
 		return false;
 	}
@@ -626,7 +715,9 @@ static bool get_dimm_temp(uint8_t addr, uint8_t type, int *reading)
 	uint8_t rbuf[rlen];
 	memset(rbuf, 0, sizeof(rbuf));
 
-	if (peci_read(PECI_CMD_RD_PKG_CFG0, addr, RDPKG_IDX_DIMM_TEMP, param, rlen, rbuf) != 0) {
+	// One response carries both DIMMs of the channel, the sibling sensor reuses it
+	if (intel_peci_rdpkg_read_cached(addr, RDPKG_IDX_DIMM_TEMP, param, rlen, rbuf,
+					 PECI_RDPKG_CACHE_WINDOW_MS) != 0) {
 		LOG_ERR("PECI read error");
 		return false;
 	}
@@ -635,12 +726,12 @@ static bool get_dimm_temp(uint8_t addr, uint8_t type, int *reading)
 	return true;
 }
 
-static bool get_dimm_total_pwr(uint8_t addr, int *reading)
+static bool get_dimm_total_pwr(sensor_cfg *cfg, int *reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(reading, false);
 
 	int total_pwr = 0;
-	if (read_total_dimm_power(addr, &total_pwr) == false) {
+	if (read_total_dimm_power(cfg, cfg->target_addr, &total_pwr) == false) {
 		LOG_ERR("Read total DIMM power error");
 		return false;
 	}
@@ -696,10 +787,10 @@ uint8_t intel_peci_read(sensor_cfg *cfg, int *reading)
 		ret_val = get_cpu_temp(cfg->target_addr, reading);
 		break;
 	case PECI_PWR_CPU:
-		ret_val = get_cpu_pwr(cfg->target_addr, reading);
+		ret_val = get_cpu_pwr(cfg, reading);
 		break;
 	case PECI_POWER_TOTAL_DIMM:
-		ret_val = get_dimm_total_pwr(cfg->target_addr, reading);
+		ret_val = get_dimm_total_pwr(cfg, reading);
 		break;
 	default:
 		break;
@@ -40,14 +40,22 @@ LOG_MODULE_REGISTER(lattice);
 #define ISC_ERASE 0x0E
 #define ISC_DISABLE 0x26
 
-uint8_t new_line[] = { 0x0d, 0x0a };
 #define TAG_CFG_START_STR "L000"
 #define TAG_CFG_END_STR "*"
 #define TAG_USER_CODE_STR "UH"
 #define CFG_BYTE_PER_LINE 128
-#define MAX_TRANS_LEN (CFG_BYTE_PER_LINE + 2) //add new line ascii bytes
+#define CFG_BYTE_PER_PAGE 16
+#define USER_CODE_OFS (strlen(TAG_USER_CODE_STR) + 2)
+#define USER_CODE_LEN 8
 #define CPLD_FW_BOTTOM_PART_LENGTH 260
 
+/* A page program takes well under a millisecond. k_usleep rounds up to at least one tick, so
+ * the first polls busy-wait CPLD_PAGE_BUSY_POLL_US between reads and only a slow page sleeps.
+ */
+#define CPLD_PAGE_BUSY_POLL_US 50
+#define CPLD_PAGE_BUSY_SPIN_COUNT 20
+#define CPLD_PAGE_BUSY_TIMEOUT_MS 1000
+
 enum data_passing_state {
 	DATA_PASSING_FIRST,
 	DATA_PASSING_STARTED,
@@ -58,6 +66,16 @@ enum data_passing_state {
 	DATA_PASSING_ENDED,
 };
 
+/* JED parsing state kept across received chunks, so chunks may split a line anywhere */
+static struct {
+	uint8_t state;
+	bool first_page;
+	bool page_pending; // a page was sent and its busy flag is not checked yet
+	uint32_t stream_ofs; // image offset the next chunk must start at
+	uint32_t line_len; // length of the current line, may exceed the buffer
+	char line[CFG_BYTE_PER_LINE];
+} jed_parser;
+
 static bool x02x03_i2c_update(lattice_update_config_t *config);
 static bool x02x03_jtag_update(lattice_update_config_t *config);
 
@@ -134,7 +152,7 @@ static bool cfg_data_parsing(char *data, uint32_t *result, int len)
 
 	int result_index = 0, data_index = 0;
 	int bit_count = 0;
-	memset(result, 0, len);
+	memset(result, 0, len / 8); // one bit per character
 
 	for (int i = 0; i < len; i++) {
 		data[i] = data[i] - 0x30;
@@ -166,7 +184,7 @@ static bool user_code_parsing(char *data, uint32_t *result, int len)
 
 	int result_index = 0, data_index = 8;
 	int bit_count = 0;
-	memset(result, 0, len);
+	memset(result, 0, len / 2); // one nibble per character
 
 	for (int i = 0; i < len; i++) {
 		data[i] = ascii_to_val(data[i]);
@@ -180,25 +198,38 @@ static bool user_code_parsing(char *data, uint32_t *result, int len)
 	return true;
 }
 
-static bool read_cpld_busy_flag(uint8_t bus, uint8_t addr, uint16_t sleep_ms)
+static bool get_cpld_busy_flag(uint8_t bus, uint8_t addr, bool *busy)
 {
+	CHECK_NULL_ARG_WITH_RETURN(busy, false);
+
 	//support XO2, XO3, NX
-	for (int retry = 0; retry < CHECK_STATUS_RETRY; retry++) {
-		I2C_MSG i2c_msg = { 0 };
-		uint8_t retry = 3;
-		i2c_msg.bus = bus;
-		i2c_msg.target_addr = addr;
+	I2C_MSG i2c_msg = { 0 };
+	uint8_t retry = 3;
+	i2c_msg.bus = bus;
+	i2c_msg.target_addr = addr;
 
-		i2c_msg.tx_len = 4;
-		i2c_msg.rx_len = 1;
-		memset(i2c_msg.data, 0, i2c_msg.tx_len);
-		i2c_msg.data[0] = LSC_CHECK_BUSY;
-		if (i2c_master_read(&i2c_msg, retry)) {
-			LOG_ERR("Failed to send read_cpld_busy_flag cmd");
+	i2c_msg.tx_len = 4;
+	i2c_msg.rx_len = 1;
+	memset(i2c_msg.data, 0, i2c_msg.tx_len);
+	i2c_msg.data[0] = LSC_CHECK_BUSY;
+	if (i2c_master_read(&i2c_msg, retry)) {
+		LOG_ERR("Failed to send read_cpld_busy_flag cmd");
+		return false;
+	}
+
+	*busy = (((i2c_msg.data[0] & 0x80) >> 7) != 0x0);
+	return true;
+}
+
+static bool read_cpld_busy_flag(uint8_t bus, uint8_t addr, uint16_t sleep_ms)
+{
+	for (int retry = 0; retry < CHECK_STATUS_RETRY; retry++) {
+		bool busy = true;
+		if (get_cpld_busy_flag(bus, addr, &busy) == false) {
 			return false;
 		}
 
-		if (((i2c_msg.data[0] & 0x80) >> 7) == 0x0) {
+		if (busy == false) {
 			return true;
 		}
 		k_msleep(sleep_ms);
@@ -208,6 +239,33 @@ static bool read_cpld_busy_flag(uint8_t bus, uint8_t addr, uint16_t sleep_ms)
 	return false;
 }
 
+static bool wait_cpld_page_done(uint8_t bus, uint8_t addr)
+{
+	int64_t deadline = k_uptime_get() + CPLD_PAGE_BUSY_TIMEOUT_MS;
+	int poll_count = 0;
+
+	do {
+		bool busy = true;
+		if (get_cpld_busy_flag(bus, addr, &busy) == false) {
+			return false;
+		}
+
+		if (busy == false) {
+			return true;
+		}
+
+		if (poll_count < CPLD_PAGE_BUSY_SPIN_COUNT) {
+			k_busy_wait(CPLD_PAGE_BUSY_POLL_US);
+			poll_count++;
+		} else {
+			k_usleep(CPLD_PAGE_BUSY_POLL_US);
+		}
+	} while (k_uptime_get() < deadline);
+
+	LOG_ERR("CPLD is still busy after %d ms of page programming", CPLD_PAGE_BUSY_TIMEOUT_MS);
+	return false;
+}
+
 static bool read_cpld_status0_flag(uint8_t bus, uint8_t addr, uint16_t sleep_ms)
 {
 	for (int retry = 0; retry < CHECK_STATUS_RETRY; retry++) {
@@ -501,6 +559,9 @@ static bool program_user_code(uint8_t bus, uint8_t addr, uint32_t usrcode, latti
 	return (memcmp(&read_usrcode, &usrcode, i2c_msg.rx_len) == 0) ? true : false;
 }
 
+/* Send one page without waiting for it, the busy flag is checked right before the next command so
+ * the CPLD programs the page while the following JED line is being received and parsed.
+ */
 static bool cpld_program_i2c(uint8_t bus, uint8_t addr, uint8_t *buff, lattice_dev_type_t type,
 			     uint8_t sector, bool first_flag)
 {
@@ -517,12 +578,12 @@ static bool cpld_program_i2c(uint8_t bus, uint8_t addr, uint8_t *buff, lattice_d
 	i2c_msg.bus = bus;
 	i2c_msg.target_addr = addr;
 
-	i2c_msg.tx_len = 4 + 16;
+	i2c_msg.tx_len = 4 + CFG_BYTE_PER_PAGE;
 	memset(i2c_msg.data, 0, i2c_msg.tx_len);
 	i2c_msg.data[0] = LSC_PROG_INCR_NV;
 	i2c_msg.data[3] = 0x01;
 
-	for (int index = 0; index < 16; index++) {
+	for (int index = 0; index < CFG_BYTE_PER_PAGE; index++) {
 		i2c_msg.data[index + 4] = bit_swap(buff[index]);
 	}
 
@@ -531,10 +592,6 @@ static bool cpld_program_i2c(uint8_t bus, uint8_t addr, uint8_t *buff, lattice_d
 		return false;
 	}
 
-	if (read_cpld_busy_flag(bus, addr, 10) == false) {
-		return false;
-	}
-
 	return true;
 }
 
@@ -606,11 +663,78 @@ bool cpld_i2c_get_usercode(uint8_t bus, uint8_t addr, uint32_t *usercode)
 	return true;
 }
 
-static bool x02x03_i2c_update(lattice_update_config_t *config)
+static bool jed_flush_page(lattice_update_config_t *config)
 {
 	CHECK_NULL_ARG_WITH_RETURN(config, false);
 
-	config->next_ofs = 0;
+	if (jed_parser.page_pending == false) {
+		return true;
+	}
+
+	jed_parser.page_pending = false;
+	return wait_cpld_page_done(config->bus, config->addr);
+}
+
+/* Handle one complete JED line, CR and LF are already stripped */
+static bool jed_parse_line(lattice_update_config_t *config)
+{
+	CHECK_NULL_ARG_WITH_RETURN(config, false);
+
+	uint32_t program_buff[CFG_BYTE_PER_PAGE / sizeof(uint32_t)];
+
+	switch (jed_parser.state) {
+	case DATA_PASSING_STARTED:
+		if ((jed_parser.line_len >= strlen(TAG_CFG_START_STR)) &&
+		    !memcmp(jed_parser.line, TAG_CFG_START_STR, strlen(TAG_CFG_START_STR))) {
+			jed_parser.state = DATA_PASSING_CFG_STARTED;
+			jed_parser.first_page = true;
+		}
+		break;
+
+	case DATA_PASSING_CFG_STARTED:
+		if ((jed_parser.line_len >= strlen(TAG_CFG_END_STR)) &&
+		    !memcmp(jed_parser.line, TAG_CFG_END_STR, strlen(TAG_CFG_END_STR))) {
+			jed_parser.state = DATA_PASSING_CFG_ENDED;
+			return jed_flush_page(config);
+		}
+
+		if (jed_parser.line_len != CFG_BYTE_PER_LINE) {
+			LOG_ERR("Unexpected cfg data line length %d", jed_parser.line_len);
+			return false;
+		}
+
+		if (cfg_data_parsing(jed_parser.line, program_buff, CFG_BYTE_PER_LINE) == false) {
+			return false;
+		}
+
+		if (jed_flush_page(config) == false) {
+			return false;
+		}
+
+		if (cpld_program_i2c(config->bus, config->addr, (uint8_t *)&program_buff,
+				     config->type, CFG0, jed_parser.first_page) == false) {
+			LOG_ERR("Failed to program cpld via i2c");
+			return false;
+		}
+
+		jed_parser.page_pending = true;
+		jed_parser.first_page = false;
+		break;
+
+	case DATA_PASSING_CFG_ENDED:
+		break;
+
+	default:
+		LOG_ERR("Unexpected passing state %d", jed_parser.state);
+		return false;
+	}
+
+	return true;
+}
+
+static bool x02x03_i2c_update(lattice_update_config_t *config)
+{
+	CHECK_NULL_ARG_WITH_RETURN(config, false);
 
 	if (config->type >= ARRAY_SIZE(LATTICE_CFG_TABLE)) {
 		LOG_ERR("Non-support type %d of lattice device detect", config->type);
@@ -641,105 +765,105 @@ static bool x02x03_i2c_update(lattice_update_config_t *config)
 			LOG_ERR("Failed to erase flash");
 			return false;
 		}
-	}
-
-	/* Step2. Image parsing and update */
-	uint8_t data_buff[CFG_BYTE_PER_LINE];
-	memset(data_buff, 0, sizeof(data_buff));
-	uint32_t program_buff[4];
-	memset(program_buff, 0, sizeof(program_buff));
-	uint32_t user_code_buff[1];
-	memset(user_code_buff, 0, sizeof(user_code_buff));
-
-	static bool first_flag = false;
-	static uint8_t passing_state = DATA_PASSING_FIRST;
-
-	memcpy(data_buff, config->data, config->data_len);
 
-	int idx = 0;
-	for (idx = 0; idx < (config->data_len - sizeof(new_line) + 1); idx++) {
-		if (!memcmp(config->data + idx, new_line, sizeof(new_line))) {
-			config->next_ofs = config->data_ofs + idx + 2;
-			config->next_len = MAX_TRANS_LEN;
-			break;
-		}
+		memset(&jed_parser, 0, sizeof(jed_parser));
+		jed_parser.state = DATA_PASSING_STARTED;
 	}
 
-	// if '\n' not found
-	if (idx == (config->data_len - sizeof(new_line) + 1)) {
-		LOG_ERR("Failed to find new line ascii bytes in received data");
+	if (config->data_ofs != jed_parser.stream_ofs) {
+		LOG_ERR("Received data offset 0x%x but expected 0x%x", config->data_ofs,
+			jed_parser.stream_ofs);
 		return false;
 	}
 
-	switch (passing_state) {
-	case DATA_PASSING_FIRST:
-	case DATA_PASSING_STARTED:
-		if (!memcmp(config->data, TAG_CFG_START_STR, strlen(TAG_CFG_START_STR))) {
-			passing_state = DATA_PASSING_CFG_STARTED;
-			first_flag = true;
+	/* Step2. Image parsing and update, lines may be split anywhere between chunks */
+	uint32_t idx = 0;
+	for (idx = 0; idx < config->data_len; idx++) {
+		char ch = config->data[idx];
+
+		if (jed_parser.state == DATA_PASSING_UC_STARTED) {
+			// The user code is taken at a fixed offset from the start of its tag
+			jed_parser.line[jed_parser.line_len++] = ch;
+			if (jed_parser.line_len == (USER_CODE_OFS + USER_CODE_LEN)) {
+				jed_parser.state = DATA_PASSING_UC_ENDED;
+				idx++;
+				break;
+			}
+			continue;
 		}
-		break;
 
-	case DATA_PASSING_CFG_STARTED:
-		if (!memcmp(config->data, TAG_CFG_END_STR, strlen(TAG_CFG_END_STR))) {
-			passing_state = DATA_PASSING_CFG_ENDED;
+		if (ch == '\r') {
+			continue;
+		}
 
-			/*To reduce update time, jump offset to the bottom part of the image after 
-			config data transfered, the offset must be in front of the user code*/
-			config->next_ofs = fw_update_cfg.image_size - CPLD_FW_BOTTOM_PART_LENGTH;
-		} else {
-			if (cfg_data_parsing(config->data, program_buff, CFG_BYTE_PER_LINE) ==
-			    false) {
+		if (ch == '\n') {
+			uint8_t prev_state = jed_parser.state;
+			if (jed_parse_line(config) == false) {
 				return false;
 			}
-
-			if (cpld_program_i2c(config->bus, config->addr, (uint8_t *)&program_buff,
-					     config->type, CFG0, first_flag) == false) {
-				LOG_ERR("Failed to program cpld via i2c");
-				return false;
+			jed_parser.line_len = 0;
+
+			if ((prev_state == DATA_PASSING_CFG_STARTED) &&
+			    (jed_parser.state == DATA_PASSING_CFG_ENDED)) {
+				/* To reduce update time, jump offset to the bottom part of the
+				 * image after config data transfered, the offset must be in front
+				 * of the user code
+				 */
+				uint32_t bottom_ofs =
+					fw_update_cfg.image_size - CPLD_FW_BOTTOM_PART_LENGTH;
+				if (bottom_ofs > config->data_ofs + idx + 1) {
+					jed_parser.stream_ofs = bottom_ofs;
+					break;
+				}
 			}
+			continue;
+		}
 
-			first_flag = false;
+		if (jed_parser.line_len < sizeof(jed_parser.line)) {
+			jed_parser.line[jed_parser.line_len] = ch;
 		}
-		break;
+		jed_parser.line_len++;
 
-	case DATA_PASSING_CFG_ENDED:
-		if (!memcmp(config->data, TAG_USER_CODE_STR, strlen(TAG_USER_CODE_STR))) {
-			if (user_code_parsing(data_buff + strlen(TAG_USER_CODE_STR) + 2,
-					      user_code_buff, 8) == false) {
-				LOG_ERR("Failed to parsing user code");
-				return false;
-			}
+		if ((jed_parser.state == DATA_PASSING_CFG_ENDED) &&
+		    (jed_parser.line_len == strlen(TAG_USER_CODE_STR)) &&
+		    !memcmp(jed_parser.line, TAG_USER_CODE_STR, strlen(TAG_USER_CODE_STR))) {
+			jed_parser.state = DATA_PASSING_UC_STARTED;
+		}
+	}
 
-			uint32_t user_code = user_code_buff[0];
-			if (program_user_code(config->bus, config->addr, user_code, config->type) ==
-			    false) {
-				return false;
-			}
+	/* Step3. Request the next chunk as large as the UA allows */
+	if (jed_parser.state != DATA_PASSING_UC_ENDED) {
+		if (idx == config->data_len) {
+			jed_parser.stream_ofs = config->data_ofs + config->data_len;
+		}
 
-			config->next_len = 0;
-			passing_state = DATA_PASSING_FIRST;
+		if (jed_parser.stream_ofs >= fw_update_cfg.image_size) {
+			LOG_ERR("Image ended before user code, passing state %d", jed_parser.state);
+			return false;
 		}
-		break;
 
-	default:
-		LOG_ERR("Unexpected passing state %d", passing_state);
-		return false;
+		config->next_ofs = jed_parser.stream_ofs;
+		config->next_len = MIN(fw_update_cfg.max_buff_size,
+				       fw_update_cfg.image_size - config->next_ofs);
+		return true;
 	}
 
-	// if next_ofs not set
-	if (config->next_ofs == 0) {
-		LOG_INF("next_ofs = data_ofs");
-		config->next_ofs = config->data_ofs + MAX_TRANS_LEN;
-		config->next_len = MAX_TRANS_LEN;
+	/* Step4. After update */
+	uint32_t user_code_buff[1];
+	memset(user_code_buff, 0, sizeof(user_code_buff));
+	if (user_code_parsing(jed_parser.line + USER_CODE_OFS, user_code_buff, USER_CODE_LEN) ==
+	    false) {
+		LOG_ERR("Failed to parsing user code");
+		return false;
 	}
 
-	/* Step3. After update*/
-	if (config->next_len != 0) {
-		if (config->next_ofs + config->next_len >= fw_update_cfg.image_size) {
-			config->next_len = fw_update_cfg.image_size - config->next_ofs;
-		}
-		return true;
+	jed_parser.state = DATA_PASSING_ENDED;
+	config->next_ofs = 0;
+	config->next_len = 0;
+
+	if (program_user_code(config->bus, config->addr, user_code_buff[0], config->type) ==
+	    false) {
+		return false;
 	}
 
 	if (program_done(config->bus, config->addr, config->type) == false) {
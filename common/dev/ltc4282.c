@@ -18,6 +18,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "sensor.h"
+#include "sensor_energy.h"
 #include "hal_i2c.h"
 #include <logging/log.h>
 
@@ -225,6 +226,7 @@ uint8_t ltc4282_read(sensor_cfg *cfg, int *reading)
 			return SENSOR_FAIL_TO_ACCESS;
 		}
 		val = (val * 16.64 * 0.04 * 256 / 65535 / 65535 / rsense_mohm);
+		sensor_energy_accumulate(cfg, val);
 		break;
 	default:
 		LOG_ERR("Invalid sensor 0x%x offset 0x%x", cfg->num, cfg->offset);
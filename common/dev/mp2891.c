@@ -104,23 +104,15 @@ float mp2891_get_resolution(sensor_cfg *cfg)
 
 	uint8_t offset = cfg->offset;
 	float reso = 0;
-
-	I2C_MSG msg;
-	uint8_t i2c_max_retry = 5;
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 2;
+	uint8_t data[2] = { 0 };
 
 	switch (offset) {
 	case PMBUS_READ_VOUT:
-		msg.data[0] = MFR_VOUT_LOOP_CTRL;
-
-		if (i2c_master_read(&msg, i2c_max_retry)) {
+		if (pmbus_read_static_reg(cfg, MFR_VOUT_LOOP_CTRL, data, sizeof(data))) {
 			LOG_WRN("I2C read failed");
 			return reso;
 		}
-		uint16_t mfr_vout_loop_ctrl = (msg.data[1] << 8) | msg.data[0];
+		uint16_t mfr_vout_loop_ctrl = (data[1] << 8) | data[0];
 
 		if (mfr_vout_loop_ctrl & DAC_2P5MV_EN_BIT) {
 			reso = 0.0025;
@@ -134,13 +126,11 @@ float mp2891_get_resolution(sensor_cfg *cfg)
 		}
 		return reso;
 	case PMBUS_READ_IOUT:
-		msg.data[0] = MFR_SVI3_IOUT_RPT;
-
-		if (i2c_master_read(&msg, i2c_max_retry)) {
+		if (pmbus_read_static_reg(cfg, MFR_SVI3_IOUT_RPT, data, sizeof(data))) {
 			LOG_WRN("I2C read failed");
 			return reso;
 		}
-		uint16_t mfr_svi3_iout_prt_data = (msg.data[1] << 8) | msg.data[0];
+		uint16_t mfr_svi3_iout_prt_data = (data[1] << 8) | data[0];
 
 		switch (mfr_svi3_iout_prt_data & IOUT_SCALE_MASK) {
 		case 0:
@@ -243,6 +233,8 @@ uint8_t mp2891_init(sensor_cfg *cfg)
 		return SENSOR_INIT_UNSPECIFIED_ERROR;
 	}
 
+	pmbus_reg_cache_invalidate(cfg->port, cfg->target_addr);
+
 	cfg->read = mp2891_read;
 	return SENSOR_INIT_SUCCESS;
 }
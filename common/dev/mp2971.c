@@ -679,6 +679,8 @@ bool mp2971_fwupdate(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t img_
 
 	ret = true;
 exit:
+	// The new image may carry different resolution and scale settings
+	pmbus_reg_cache_invalidate(bus, addr);
 	SAFE_FREE(dev_cfg.pdata);
 	return ret;
 }
@@ -733,22 +735,15 @@ bool mp2971_get_checksum(uint8_t bus, uint8_t addr, uint32_t *checksum)
 bool get_vout_scale(const sensor_cfg *cfg, float *vout_scale)
 {
 	CHECK_NULL_ARG_WITH_RETURN(vout_scale, false);
-	uint8_t i2c_max_retry = 5;
-	I2C_MSG msg;
+	uint8_t data[2] = { 0 };
 
 	//Read MP2971_VOUT_SENSE_SET (29h)
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 2;
-	msg.data[0] = MP2971_VOUT_SENSE_SET;
-
-	if (i2c_master_read(&msg, i2c_max_retry)) {
+	if (pmbus_read_static_reg(cfg, MP2971_VOUT_SENSE_SET, data, sizeof(data))) {
 		LOG_WRN("MP2971 VOUT sense set (0x29) read failed");
 		return false;
 	}
 
-	uint16_t vout_sense_set = (msg.data[1] << 8) | msg.data[0];
+	uint16_t vout_sense_set = (data[1] << 8) | data[0];
 
 	/* vout_scale = (2^5) / (VOUT_SENSE_SET & 0x1FF) */
 	*vout_scale = ((float)(1 << 5)) / ((float)(vout_sense_set & MP2971_VOUT_SCALE_MASK));
@@ -767,34 +762,21 @@ float get_resolution(sensor_cfg *cfg)
 
 	uint8_t page = 0;
 	uint16_t mfr_reso_set = 0;
+	uint8_t data[2] = { 0 };
 
-	I2C_MSG msg;
-	uint8_t i2c_max_retry = 5;
-
-	//get page
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 1;
-	msg.data[0] = PMBUS_PAGE;
-
-	if (i2c_master_read(&msg, i2c_max_retry)) {
+	//get page, usually known from the PAGE the pre-read hook selected
+	if (pmbus_get_page(cfg->port, cfg->target_addr, &page)) {
 		LOG_WRN("I2C read failed");
 		return SENSOR_FAIL_TO_ACCESS;
 	}
 
-	page = msg.data[0];
-
-	//get reso set
-	msg.rx_len = 2;
-	msg.data[0] = MFR_RESO_SET;
-
-	if (i2c_master_read(&msg, i2c_max_retry)) {
+	//get reso set, fixed until the next VR update
+	if (pmbus_read_static_reg(cfg, MFR_RESO_SET, data, sizeof(data))) {
 		LOG_WRN("I2C read failed");
 		return SENSOR_FAIL_TO_ACCESS;
 	}
 
-	mfr_reso_set = (msg.data[1] << 8) | msg.data[0];
+	mfr_reso_set = (data[1] << 8) | data[0];
 
 	uint8_t vout_reso_set;
 	uint8_t iout_reso_set;
@@ -1961,6 +1943,9 @@ uint8_t mp2971_init(sensor_cfg *cfg)
 		return SENSOR_INIT_UNSPECIFIED_ERROR;
 	}
 
+	// Resolution and scale settings may differ after a re-init, read them again on next poll
+	pmbus_reg_cache_invalidate(cfg->port, cfg->target_addr);
+
 	cfg->read = mp2971_read;
 	return SENSOR_INIT_SUCCESS;
 }
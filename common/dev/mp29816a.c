@@ -562,6 +562,8 @@ bool mp29816a_fwupdate(uint8_t bus, uint8_t addr, uint8_t *img_buff, uint32_t im
 
 	ret = true;
 exit:
+	// The new image may carry different resolution settings
+	pmbus_reg_cache_invalidate(bus, addr);
 	free(cfg_data_list);
 	return ret;
 }
@@ -602,24 +604,16 @@ float mp29816a_get_resolution(sensor_cfg *cfg, bool is_vout_max_or_min)
 		offset = PMBUS_VOUT_MAX;
 	}
 	float reso = 0;
-
-	I2C_MSG msg;
-	uint8_t i2c_max_retry = 5;
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 2;
+	uint8_t data[2] = { 0 };
 
 	switch (offset) {
 	case PMBUS_READ_VOUT:
 	case PMBUS_VOUT_MAX:
-		msg.data[0] = MFR_VOUT_SCALE_LOOP;
-
-		if (i2c_master_read(&msg, i2c_max_retry)) {
+		if (pmbus_read_static_reg(cfg, MFR_VOUT_SCALE_LOOP, data, sizeof(data))) {
 			LOG_WRN("I2C read failed");
 			break;
 		}
-		uint16_t mfr_vout_scale_loop = (msg.data[1] << 8) | msg.data[0];
+		uint16_t mfr_vout_scale_loop = (data[1] << 8) | data[0];
 		switch ((mfr_vout_scale_loop & MFR_VID_RES_MASK) >> 10) {
 		case 0:
 			reso = 0.00625;
@@ -1256,6 +1250,8 @@ uint8_t mp29816a_init(sensor_cfg *cfg)
 		return SENSOR_INIT_UNSPECIFIED_ERROR;
 	}
 
+	pmbus_reg_cache_invalidate(cfg->port, cfg->target_addr);
+
 	cfg->read = mp29816a_read;
 	return SENSOR_INIT_SUCCESS;
 }
@@ -943,6 +943,7 @@ uint8_t mp2985_init(sensor_cfg *cfg)
 		LOG_ERR("failed to vout mode");
 		return SENSOR_INIT_UNSPECIFIED_ERROR;
 	}
+	pmbus_reg_cache_invalidate(cfg->port, cfg->target_addr);
 
 	init_args->is_init = true;
 
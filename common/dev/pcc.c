@@ -48,6 +48,24 @@
 #define PCCR0_EN BIT(0)
 #define POST_CODE_SIZE 4
 
+#ifdef PLAT_PCC_POSTCODE_BATCH_MAX
+#define PCC_POSTCODE_BATCH_MAX PLAT_PCC_POSTCODE_BATCH_MAX
+#else
+#define PCC_POSTCODE_BATCH_MAX PCC_POSTCODE_BATCH_MAX_DEFAULT
+#endif
+
+#ifdef PLAT_PCC_POSTCODE_MAX_INFLIGHT
+#define PCC_POSTCODE_MAX_INFLIGHT PLAT_PCC_POSTCODE_MAX_INFLIGHT
+#else
+#define PCC_POSTCODE_MAX_INFLIGHT PCC_POSTCODE_MAX_INFLIGHT_DEFAULT
+#endif
+
+#ifdef PLDM_MSG_MAX_RETRY
+#define PCC_POSTCODE_MAX_RETRY PLDM_MSG_MAX_RETRY
+#else
+#define PCC_POSTCODE_MAX_RETRY PCC_POSTCODE_MAX_RETRY_DEFAULT
+#endif
+
 LOG_MODULE_REGISTER(pcc);
 
 K_THREAD_STACK_DEFINE(process_postcode_thread, PROCESS_POSTCODE_STACK_SIZE);
@@ -58,6 +76,23 @@ static uint32_t pcc_read_buffer[PCC_BUFFER_LEN];
 static uint16_t pcc_read_len = 0, pcc_read_index = 0;
 static bool proc_4byte_postcode_ok = false;
 static struct k_sem get_postcode_sem;
+/* Codes stored since boot, the consumer derives the ring position from it */
+static uint32_t pcc_postcode_count = 0;
+static uint32_t pcc_postcode_overrun = 0;
+#ifdef ENABLE_PLDM
+typedef struct _pldm_post_code_req {
+	uint32_t postcode[PCC_POSTCODE_BATCH_MAX];
+	uint16_t count;
+	uint8_t retry;
+} pldm_post_code_req;
+
+/* One slot per request in flight, held until the BMC replies or the request times out */
+K_MEM_SLAB_DEFINE(post_code_req_slab, ROUND_UP(sizeof(pldm_post_code_req), 4),
+		  PCC_POSTCODE_MAX_INFLIGHT, 4);
+/* Timed out requests, resent by process_postcode. Each one gave back a slot, and only one more
+ * can be held by process_postcode while it waits for a slot */
+K_MSGQ_DEFINE(post_code_retry_msgq, sizeof(pldm_post_code_req), PCC_POSTCODE_MAX_INFLIGHT + 1, 4);
+#endif
 
 static uint8_t PSB_error_code_list[] = { 0x03, 0x04, 0x05, 0x0B, 0x10, 0x13, 0x14, 0x18, 0x22, 0x3E,
 					 0x62, 0x64, 0x69, 0x6C, 0x6F, 0x78, 0x79, 0x7A, 0x7B, 0x7C,
@@ -272,8 +307,45 @@ void check_ABL_error(uint32_t postcode)
 }
 
 #ifdef ENABLE_PLDM
-bool pldm_send_post_code_to_bmc(uint16_t send_index)
+static void pldm_post_code_resp_handler(void *args, uint8_t *rbuf, uint16_t rlen)
 {
+	CHECK_NULL_ARG(args);
+
+	if ((rbuf != NULL) && (rlen >= sizeof(struct pldm_oem_write_file_io_resp))) {
+		struct pldm_oem_write_file_io_resp *resp =
+			(struct pldm_oem_write_file_io_resp *)rbuf;
+		if (resp->completion_code != PLDM_SUCCESS) {
+			LOG_ERR("Check reponse completion code fail %x", resp->completion_code);
+		}
+	}
+
+	k_mem_slab_free(&post_code_req_slab, &args);
+}
+
+static void pldm_post_code_timeout_handler(void *args)
+{
+	CHECK_NULL_ARG(args);
+
+	pldm_post_code_req *req = (pldm_post_code_req *)args;
+	if (req->retry < PCC_POSTCODE_MAX_RETRY) {
+		LOG_WRN("Send post code to BMC timeout, retry %d", req->retry);
+		req->retry++;
+		if (k_msgq_put(&post_code_retry_msgq, req, K_NO_WAIT) == 0) {
+			k_sem_give(&get_postcode_sem);
+		} else {
+			LOG_ERR("Post code retry queue full, drop %d post codes", req->count);
+		}
+	} else {
+		LOG_ERR("Send post code to BMC retry reach max, drop %d post codes", req->count);
+	}
+
+	k_mem_slab_free(&post_code_req_slab, &args);
+}
+
+static bool pldm_send_post_code_req(const pldm_post_code_req *src)
+{
+	CHECK_NULL_ARG_WITH_RETURN(src, false);
+
 	pldm_msg msg = { 0 };
 	uint8_t bmc_bus = I2C_BUS_BMC, bmc_interface = BMC_INTERFACE_I2C;
 
@@ -294,45 +366,76 @@ bool pldm_send_post_code_to_bmc(uint16_t send_index)
 	msg.hdr.cmd = PLDM_OEM_WRITE_FILE_IO;
 	msg.hdr.rq = 1;
 
-	struct pldm_oem_write_file_io_req *ptr = (struct pldm_oem_write_file_io_req *)malloc(
-		sizeof(struct pldm_oem_write_file_io_req) + (POST_CODE_SIZE * sizeof(uint8_t)));
+	// The request is copied out by mctp_pldm_send_msg, so the stack buffer can be reused
+	uint8_t req_buf[sizeof(struct pldm_oem_write_file_io_req) +
+			(PCC_POSTCODE_BATCH_MAX * POST_CODE_SIZE)];
+	struct pldm_oem_write_file_io_req *ptr = (struct pldm_oem_write_file_io_req *)req_buf;
 
-	if (ptr == NULL) {
-		LOG_ERR("Memory allocation failed.");
-		return false;
+	ptr->cmd_code = POST_CODE;
+	ptr->data_length = src->count * POST_CODE_SIZE;
+	for (uint16_t i = 0; i < src->count; i++) {
+		ptr->messages[(POST_CODE_SIZE * i)] = src->postcode[i] & 0xFF;
+		ptr->messages[(POST_CODE_SIZE * i) + 1] = (src->postcode[i] >> 8) & 0xFF;
+		ptr->messages[(POST_CODE_SIZE * i) + 2] = (src->postcode[i] >> 16) & 0xFF;
+		ptr->messages[(POST_CODE_SIZE * i) + 3] = (src->postcode[i] >> 24) & 0xFF;
 	}
 
-	ptr->cmd_code = POST_CODE;
-	ptr->data_length = POST_CODE_SIZE;
-	ptr->messages[0] = pcc_read_buffer[send_index] & 0xFF;
-	ptr->messages[1] = (pcc_read_buffer[send_index] >> 8) & 0xFF;
-	ptr->messages[2] = (pcc_read_buffer[send_index] >> 16) & 0xFF;
-	ptr->messages[3] = (pcc_read_buffer[send_index] >> 24) & 0xFF;
+	// Keep a bounded number of requests outstanding instead of waiting for each reply
+	pldm_post_code_req *req = NULL;
+	k_mem_slab_alloc(&post_code_req_slab, (void **)&req, K_FOREVER);
+	memcpy(req, src, sizeof(*req));
+
+	msg.buf = req_buf;
+	msg.len = sizeof(struct pldm_oem_write_file_io_req) + (src->count * POST_CODE_SIZE);
+	msg.recv_resp_cb_fn = pldm_post_code_resp_handler;
+	msg.recv_resp_cb_args = req;
+	msg.timeout_cb_fn = pldm_post_code_timeout_handler;
+	msg.timeout_cb_fn_args = req;
+
+	for (; req->retry <= PCC_POSTCODE_MAX_RETRY; req->retry++) {
+		if (mctp_pldm_send_msg(find_mctp_by_bus(bmc_bus), &msg) != PLDM_ERROR) {
+			return true;
+		}
+#ifdef PLDM_SEND_FAIL_DELAY_MS
+		k_msleep(PLDM_SEND_FAIL_DELAY_MS);
+#endif
+		LOG_WRN("mctp_pldm_send_msg fail, retry %d", req->retry);
+	}
 
-	msg.buf = (uint8_t *)ptr;
-	msg.len = sizeof(struct pldm_oem_write_file_io_req) + POST_CODE_SIZE;
+	LOG_ERR("Send post code to BMC retry reach max, drop %d post codes", req->count);
+	k_mem_slab_free(&post_code_req_slab, (void **)&req);
+	return false;
+}
 
-	uint8_t resp_len = sizeof(struct pldm_oem_write_file_io_resp);
-	uint8_t rbuf[resp_len];
+static void pldm_resend_post_code_to_bmc(void)
+{
+	pldm_post_code_req req;
 
-	if (!mctp_pldm_read(find_mctp_by_bus(bmc_bus), &msg, rbuf, resp_len)) {
-		SAFE_FREE(ptr);
-		LOG_ERR("mctp_pldm_read fail");
-		return false;
+	while (k_msgq_get(&post_code_retry_msgq, &req, K_NO_WAIT) == 0) {
+		pldm_send_post_code_req(&req);
 	}
+}
 
-	struct pldm_oem_write_file_io_resp *resp = (struct pldm_oem_write_file_io_resp *)rbuf;
-	if (resp->completion_code != PLDM_SUCCESS) {
-		LOG_ERR("Check reponse completion code fail %x", resp->completion_code);
+bool pldm_send_post_code_to_bmc(const uint32_t *postcode, uint16_t count)
+{
+	CHECK_NULL_ARG_WITH_RETURN(postcode, false);
+
+	if (count > PCC_POSTCODE_BATCH_MAX) {
+		LOG_ERR("Post code count %d over batch max %d", count, PCC_POSTCODE_BATCH_MAX);
+		return false;
 	}
 
-	SAFE_FREE(ptr);
-	return true;
+	pldm_post_code_req req = { .count = count, .retry = 0 };
+	memcpy(req.postcode, postcode, count * sizeof(uint32_t));
+
+	return pldm_send_post_code_req(&req);
 }
 #endif
 
-bool ipmi_send_post_code_to_bmc(uint16_t send_index)
+bool ipmi_send_post_code_to_bmc(const uint32_t *postcode, uint16_t count)
 {
+	CHECK_NULL_ARG_WITH_RETURN(postcode, false);
+
 	ipmi_msg *msg = (ipmi_msg *)malloc(sizeof(ipmi_msg));
 	if (msg == NULL) {
 		LOG_ERR("Memory allocation failed.");
@@ -344,15 +447,17 @@ bool ipmi_send_post_code_to_bmc(uint16_t send_index)
 	msg->InF_target = BMC_IPMB;
 	msg->netfn = NETFN_OEM_1S_REQ;
 	msg->cmd = CMD_OEM_1S_SEND_4BYTE_POST_CODE_TO_BMC;
-	msg->data_len = 8;
+	msg->data_len = 4 + (count * POST_CODE_SIZE);
 	msg->data[0] = IANA_ID & 0xFF;
 	msg->data[1] = (IANA_ID >> 8) & 0xFF;
 	msg->data[2] = (IANA_ID >> 16) & 0xFF;
-	msg->data[3] = POST_CODE_SIZE;
-	msg->data[4] = pcc_read_buffer[send_index] & 0xFF;
-	msg->data[5] = (pcc_read_buffer[send_index] >> 8) & 0xFF;
-	msg->data[6] = (pcc_read_buffer[send_index] >> 16) & 0xFF;
-	msg->data[7] = (pcc_read_buffer[send_index] >> 24) & 0xFF;
+	msg->data[3] = count * POST_CODE_SIZE;
+	for (uint16_t i = 0; i < count; i++) {
+		msg->data[4 + (POST_CODE_SIZE * i)] = postcode[i] & 0xFF;
+		msg->data[5 + (POST_CODE_SIZE * i)] = (postcode[i] >> 8) & 0xFF;
+		msg->data[6 + (POST_CODE_SIZE * i)] = (postcode[i] >> 16) & 0xFF;
+		msg->data[7 + (POST_CODE_SIZE * i)] = (postcode[i] >> 24) & 0xFF;
+	}
 	ipmb_error status = ipmb_read(msg, IPMB_inf_index_map[msg->InF_target]);
 	if (status != IPMB_ERROR_SUCCESS) {
 		SAFE_FREE(msg);
@@ -363,32 +468,62 @@ bool ipmi_send_post_code_to_bmc(uint16_t send_index)
 	return true;
 }
 
-bool send_post_code_to_bmc(uint16_t send_index)
+bool send_post_code_to_bmc(const uint32_t *postcode, uint16_t count)
 {
 #ifdef ENABLE_PLDM
-	return pldm_send_post_code_to_bmc(send_index);
+	return pldm_send_post_code_to_bmc(postcode, count);
 #else
-	return ipmi_send_post_code_to_bmc(send_index);
+	return ipmi_send_post_code_to_bmc(postcode, count);
 #endif
 }
 
 static void process_postcode(void *arvg0, void *arvg1, void *arvg2)
 {
-	uint16_t send_index = 0;
+	uint32_t sent_count = 0;
+	uint32_t postcode[PCC_POSTCODE_BATCH_MAX];
+
 	while (1) {
 		k_sem_take(&get_postcode_sem, K_FOREVER);
-		uint16_t current_read_index = pcc_read_index;
-		for (; send_index != current_read_index;
-		     send_index = (send_index + 1) % PCC_BUFFER_LEN) {
-			if (((pcc_read_buffer[send_index] >> 16) & BIT_MASK(16)) ==
-			    PSB_POSTCODE_PREFIX) {
-				check_PSB_error(pcc_read_buffer[send_index]);
-			} else if (((pcc_read_buffer[send_index] >> 16) & BIT_MASK(16)) ==
-				   ABL_POSTCODE_PREFIX) {
-				check_ABL_error(pcc_read_buffer[send_index]);
+
+		while (1) {
+#ifdef ENABLE_PLDM
+			// Batches that timed out go out again ahead of newer codes
+			pldm_resend_post_code_to_bmc();
+#endif
+			uint32_t pending = pcc_postcode_count - sent_count;
+			if (pending == 0) {
+				break;
+			}
+
+			if (pending > PCC_BUFFER_LEN) {
+				// The ring wrapped before these codes were forwarded
+				pcc_postcode_overrun += pending - PCC_BUFFER_LEN;
+				sent_count += pending - PCC_BUFFER_LEN;
+				pending = PCC_BUFFER_LEN;
+			}
+
+			uint16_t count = MIN(pending, PCC_POSTCODE_BATCH_MAX);
+			for (uint16_t i = 0; i < count; i++) {
+				postcode[i] = pcc_read_buffer[(sent_count + i) % PCC_BUFFER_LEN];
 			}
+			compiler_barrier();
 
-			send_post_code_to_bmc(send_index);
+			// Slots overwritten during the copy are dropped on the next pass
+			if ((pcc_postcode_count - sent_count) > PCC_BUFFER_LEN) {
+				continue;
+			}
+
+			for (uint16_t i = 0; i < count; i++) {
+				if (((postcode[i] >> 16) & BIT_MASK(16)) == PSB_POSTCODE_PREFIX) {
+					check_PSB_error(postcode[i]);
+				} else if (((postcode[i] >> 16) & BIT_MASK(16)) ==
+					   ABL_POSTCODE_PREFIX) {
+					check_ABL_error(postcode[i]);
+				}
+			}
+
+			send_post_code_to_bmc(postcode, count);
+			sent_count += count;
 
 			k_yield();
 		}
@@ -419,6 +554,9 @@ void pcc_rx_callback(const uint8_t *rb, uint32_t rb_sz, uint32_t st_idx, uint32_
 			if (pcc_platform_filter_postcode(four_byte_data)) {
 				pcc_read_buffer[pcc_read_index] = four_byte_data;
 				four_byte_data = 0;
+				/* Publish the slot to process_postcode only after it is written */
+				compiler_barrier();
+				pcc_postcode_count++;
 				if (pcc_read_len < PCC_BUFFER_LEN) {
 					pcc_read_len++;
 				}
@@ -490,4 +628,9 @@ void reset_4byte_postcode_ok()
 	proc_4byte_postcode_ok = false;
 }
 
+uint32_t get_pcc_postcode_overrun_count()
+{
+	return pcc_postcode_overrun;
+}
+
 #endif
@@ -31,12 +31,29 @@
 
 LOG_MODULE_REGISTER(dev_snoop);
 
-const struct device *snoop_dev;
-struct snoop_context {
-	intptr_t reserved;
-	uint32_t byte;
+#ifdef PLAT_SNOOP_RING_SIZE
+#define SNOOP_RING_SIZE PLAT_SNOOP_RING_SIZE
+#else
+#define SNOOP_RING_SIZE SNOOP_RING_SIZE_DEFAULT
+#endif
+
+/* The free running head and tail are masked into buf */
+BUILD_ASSERT((SNOOP_RING_SIZE & (SNOOP_RING_SIZE - 1)) == 0,
+	     "SNOOP_RING_SIZE must be a power of two");
+
+/* Filled from the snoop interrupt, drained by snoop_read. head and tail are free running byte
+ * counts, only the callback moves head and only the reader moves tail.
+ */
+struct snoop_ring {
+	uint8_t buf[SNOOP_RING_SIZE];
+	uint32_t head;
+	uint32_t tail;
+	uint32_t overwrite;
+	struct k_sem data_sem;
 };
-struct k_fifo snoop_fifo[SNOOP_CHANNEL_NUM];
+
+const struct device *snoop_dev;
+static struct snoop_ring snoop_ring[SNOOP_CHANNEL_NUM];
 static uint8_t *snoop_read_buffer;
 int snoop_read_num = 0;
 int send_postcode_start_position = 0;
@@ -53,35 +70,65 @@ k_tid_t send_postcode_tid;
 
 struct k_mutex snoop_mutex;
 
-int snoop_fifo_read(uint32_t ch, uint8_t *out, bool blocking)
+/* Copy out one contiguous span of up to len bytes, returns the number of bytes copied */
+int snoop_ring_read(uint32_t ch, uint8_t *out, uint16_t len, bool blocking)
 {
-	struct snoop_context *node;
-
-	if (ch >= SNOOP_CHANNEL_NUM)
+	if ((ch >= SNOOP_CHANNEL_NUM) || (out == NULL) || (len == 0))
 		return -EINVAL;
 
-	node = k_fifo_get(&snoop_fifo[ch], (blocking) ? K_FOREVER : K_NO_WAIT);
-	if (!node)
-		return -ENODATA;
+	struct snoop_ring *ring = &snoop_ring[ch];
+
+	while (1) {
+		uint32_t head = ring->head;
+		if (head == ring->tail) {
+			if (!blocking)
+				return -ENODATA;
+
+			k_sem_take(&ring->data_sem, K_FOREVER);
+			continue;
+		}
+		compiler_barrier();
+
+		uint32_t pending = head - ring->tail;
+		if (pending > SNOOP_RING_SIZE) {
+			// The callback lapped the reader, the oldest bytes are gone
+			ring->overwrite += pending - SNOOP_RING_SIZE;
+			ring->tail = head - SNOOP_RING_SIZE;
+			pending = SNOOP_RING_SIZE;
+		}
+
+		uint32_t start = ring->tail & (SNOOP_RING_SIZE - 1);
+		uint16_t count = MIN(MIN(pending, len), SNOOP_RING_SIZE - start);
+		memcpy(out, &ring->buf[start], count);
+		compiler_barrier();
 
-	*out = (uint8_t)node->byte;
+		// Bytes overwritten during the copy are counted on the next pass
+		if ((ring->head - ring->tail) > SNOOP_RING_SIZE)
+			continue;
 
-	k_free(node);
+		ring->tail += count;
+		return count;
+	}
+}
 
-	return 0;
+uint32_t get_snoop_overwrite_count(uint32_t ch)
+{
+	if (ch >= SNOOP_CHANNEL_NUM)
+		return 0;
+
+	return snoop_ring[ch].overwrite;
 }
 
 void snoop_rx_callback(const uint8_t *snoop0, const uint8_t *snoop1)
 {
 	if (snoop0) {
-		struct snoop_context *node;
-		node = k_malloc(sizeof(struct snoop_context));
-		if (node) {
-			node->byte = *snoop0;
-			k_fifo_put(&snoop_fifo[0], node);
-		} else {
-			LOG_ERR("failed to allocate node0, drop data\n");
-		}
+		struct snoop_ring *ring = &snoop_ring[0];
+
+		ring->buf[ring->head & (SNOOP_RING_SIZE - 1)] = *snoop0;
+		/* Publish the byte to the reader only after it is written */
+		compiler_barrier();
+		ring->head++;
+		k_sem_give(&ring->data_sem);
 	}
 }
 
@@ -93,11 +140,14 @@ void snoop_init()
 		return;
 	}
 
-	for (int i = 0; i < SNOOP_CHANNEL_NUM; ++i) {
-		k_fifo_init(&snoop_fifo[i]);
-	}
-
 	if (!snoop_rx_registered) {
+		for (int i = 0; i < SNOOP_CHANNEL_NUM; ++i) {
+			snoop_ring[i].head = 0;
+			snoop_ring[i].tail = 0;
+			snoop_ring[i].overwrite = 0;
+			k_sem_init(&snoop_ring[i].data_sem, 0, 1);
+		}
+
 		int rc;
 		rc = snoop_aspeed_register_rx_callback(snoop_dev, snoop_rx_callback);
 		if (rc) {
@@ -163,14 +213,17 @@ void snoop_read()
 		return;
 	}
 
-	uint8_t snoop_data;
+	uint8_t snoop_data[SNOOP_READ_SPAN_LEN];
 	while (1) {
-		rc = snoop_fifo_read(0, &snoop_data, true);
-		if (rc == 0) {
+		rc = snoop_ring_read(0, snoop_data, sizeof(snoop_data), true);
+		if (rc > 0) {
 			proc_postcode_ok = true;
 			if (!k_mutex_lock(&snoop_mutex, K_MSEC(1000))) {
-				snoop_read_buffer[snoop_read_num % SNOOP_MAX_LEN] = snoop_data;
-				snoop_read_num++;
+				for (int i = 0; i < rc; i++) {
+					snoop_read_buffer[snoop_read_num % SNOOP_MAX_LEN] =
+						snoop_data[i];
+					snoop_read_num++;
+				}
 				if (k_mutex_unlock(&snoop_mutex)) {
 					LOG_ERR("snoop read unlock fail");
 				}
@@ -20,6 +20,7 @@
 #include <logging/log.h>
 #include "libutil.h"
 #include "sensor.h"
+#include "sensor_energy.h"
 #include "sq52205.h"
 #include "hal_i2c.h"
 
@@ -183,6 +184,7 @@ uint8_t sq52205_read(sensor_cfg *cfg, int *reading)
 			return SENSOR_UNSPECIFIED_ERROR;
 		}
 		val = val * (25 * init_arg->current_lsb);
+		sensor_energy_accumulate(cfg, val);
 		break;
 	default:
 		LOG_ERR("Offset not supported: 0x%x", cfg->offset);
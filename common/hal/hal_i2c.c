@@ -22,7 +22,11 @@
 #include "hal_i2c.h"
 #include "timer.h"
 #include "plat_i2c.h"
+#include "plat_def.h"
 #include "libutil.h"
+#if defined(ENABLE_PMBUS_PAGE_CACHE) || defined(ENABLE_PMBUS_REG_CACHE)
+#include "util_pmbus.h"
+#endif
 #include <logging/log.h>
 
 LOG_MODULE_REGISTER(hal_i2c);
@@ -66,6 +70,11 @@ int i2c_freq_set(uint8_t i2c_bus, uint8_t i2c_speed_mode, uint8_t en_slave)
 		return -1;
 	}
 
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	// The controller is reinitialized, don't trust what devices on it were last told
+	pmbus_page_cache_invalidate_bus(i2c_bus);
+#endif
+
 	if (en_slave) {
 #if defined(CONFIG_I2C_ASPEED)
 		uint32_t *addr = (uint32_t *)(AST_1030_I2C_BASE + (i2c_bus * AST_1030_I2C_REG_LEN));
@@ -178,6 +187,10 @@ int i2c_master_read(I2C_MSG *msg, uint8_t retry)
 	if (i > retry)
 		LOG_ERR("I2C %d master read retry reach max with ret %d", msg->bus, ret);
 
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	pmbus_cache_track_read(msg->bus, msg->target_addr, txbuf, msg->tx_len, msg->data, ret);
+#endif
+
 exit:
 	SAFE_FREE(txbuf);
 	SAFE_FREE(rxbuf);
@@ -232,6 +245,10 @@ int i2c_master_write(I2C_MSG *msg, uint8_t retry)
 	if (i > retry)
 		LOG_ERR("I2C %d master write retry reach max with ret %d", msg->bus, ret);
 
+#if defined(ENABLE_PMBUS_PAGE_CACHE) || defined(ENABLE_PMBUS_REG_CACHE)
+	pmbus_cache_track_write(msg->bus, msg->target_addr, txbuf, msg->tx_len, ret);
+#endif
+
 exit:
 	SAFE_FREE(txbuf);
 
@@ -302,6 +319,10 @@ int i2c_master_read_without_mutex(I2C_MSG *msg, uint8_t retry)
 	if (i > retry)
 		LOG_ERR("I2C %d master read retry reach max with ret %d", msg->bus, ret);
 
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	pmbus_cache_track_read(msg->bus, msg->target_addr, txbuf, msg->tx_len, msg->data, ret);
+#endif
+
 exit:
 	SAFE_FREE(txbuf);
 	SAFE_FREE(rxbuf);
@@ -345,6 +366,10 @@ int i2c_master_write_without_mutex(I2C_MSG *msg, uint8_t retry)
 	if (i > retry)
 		LOG_ERR("I2C %d master write retry reach max with ret %d", msg->bus, ret);
 
+#if defined(ENABLE_PMBUS_PAGE_CACHE) || defined(ENABLE_PMBUS_REG_CACHE)
+	pmbus_cache_track_write(msg->bus, msg->target_addr, txbuf, msg->tx_len, ret);
+#endif
+
 exit:
 	SAFE_FREE(txbuf);
 
@@ -582,6 +607,10 @@ int i2c_master_read_without_error_log(I2C_MSG *msg, uint8_t retry)
 		}
 	}
 
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	pmbus_cache_track_read(msg->bus, msg->target_addr, txbuf, msg->tx_len, msg->data, ret);
+#endif
+
 exit:
 	SAFE_FREE(txbuf);
 	SAFE_FREE(rxbuf);
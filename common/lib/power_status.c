@@ -21,6 +21,7 @@
 
 #include "hal_gpio.h"
 #include "snoop.h"
+#include "util_pmbus.h"
 
 LOG_MODULE_REGISTER(power_status);
 
@@ -28,6 +29,7 @@ static bool is_DC_on = false;
 static bool is_DC_on_delayed = false;
 static bool is_DC_off_delayed = false;
 static bool is_CPU_power_good = false;
+static uint32_t CPU_power_change_count = 0;
 static bool is_post_complete = false;
 static bool vr_monitor_status = true;
 static bool is_P3V3_E1S_power_good = false;
@@ -37,6 +39,9 @@ void set_DC_status(uint8_t gpio_num)
 {
 	is_DC_on = (gpio_get(gpio_num) == 1) ? true : false;
 	LOG_WRN("DC_STATUS: %s", (is_DC_on) ? "on" : "off");
+
+	// VRs come back on their default PAGE after losing power
+	pmbus_page_cache_reset();
 }
 
 bool get_DC_status()
@@ -90,6 +95,7 @@ bool get_post_status()
 void set_CPU_power_status(uint8_t gpio_num)
 {
 	is_CPU_power_good = gpio_get(gpio_num);
+	CPU_power_change_count++;
 	LOG_WRN("CPU_PWR_GOOD: %s", (is_CPU_power_good) ? "yes" : "no");
 }
 
@@ -98,6 +104,12 @@ bool CPU_power_good()
 	return is_CPU_power_good;
 }
 
+/* Bumped on every CPU power good edge, lets drivers drop values cached from the last boot */
+uint32_t get_CPU_power_change_count()
+{
+	return CPU_power_change_count;
+}
+
 void set_post_thread()
 {
 	if (CPU_power_good() == true) {
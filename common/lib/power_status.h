@@ -32,6 +32,7 @@ void set_post_complete(bool status);
 bool get_post_status();
 void set_CPU_power_status(uint8_t gpio_num);
 bool CPU_power_good();
+uint32_t get_CPU_power_change_count();
 void set_post_thread();
 void set_vr_monitor_status(bool value);
 bool get_vr_monitor_status();
@@ -15,13 +15,61 @@
  */
 
 #include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
 #include <logging/log.h>
 #include "sensor.h"
 #include "hal_i2c.h"
 #include "pmbus.h"
+#include "util_pmbus.h"
 
 LOG_MODULE_REGISTER(util_pmbus);
 
+#ifndef PMBUS_PAGE_CACHE_SIZE
+#define PMBUS_PAGE_CACHE_SIZE PMBUS_PAGE_CACHE_SIZE_DEFAULT
+#endif
+
+typedef struct _pmbus_page_cache_entry {
+	uint8_t bus;
+	uint8_t addr;
+	uint8_t page;
+	bool used;
+	bool valid;
+} pmbus_page_cache_entry;
+
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+/* Last PAGE written to or read from each device, every I2C transfer keeps it up to date */
+static pmbus_page_cache_entry pmbus_page_cache[PMBUS_PAGE_CACHE_SIZE];
+static uint8_t pmbus_page_cache_victim = 0;
+static struct k_spinlock pmbus_page_cache_lock;
+#endif
+
+#ifndef PMBUS_REG_CACHE_SIZE
+#define PMBUS_REG_CACHE_SIZE PMBUS_REG_CACHE_SIZE_DEFAULT
+#endif
+
+typedef struct _pmbus_reg_cache_entry {
+	const sensor_cfg *cfg;
+	uint8_t bus;
+	uint8_t addr;
+	uint8_t reg;
+	uint8_t len;
+	uint8_t data[PMBUS_REG_CACHE_DATA_MAX];
+	bool valid;
+} pmbus_reg_cache_entry;
+
+#ifdef ENABLE_PMBUS_REG_CACHE
+/* Static configuration registers (VOUT_MODE, resolution and scale settings) per sensor config
+ * entry. Entries are never evicted, the table doubles whenever a new (sensor, register) pair
+ * does not fit, so it ends up sized to the sensors that actually use it.
+ */
+static pmbus_reg_cache_entry *pmbus_reg_cache = NULL;
+static uint16_t pmbus_reg_cache_count = 0;
+static uint16_t pmbus_reg_cache_size = 0;
+static struct k_spinlock pmbus_reg_cache_lock;
+#endif
+
 const float slinear11_exponents[32] = { 1.0,
 					2.0,
 					4.0,
@@ -78,20 +126,13 @@ bool get_exponent_from_vout_mode(sensor_cfg *cfg, float *exponent)
 	CHECK_NULL_ARG_WITH_RETURN(cfg, false);
 	CHECK_NULL_ARG_WITH_RETURN(exponent, false);
 
-	uint8_t retry = 5;
-	I2C_MSG msg;
+	uint8_t vout_mode = 0;
 
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 1;
-	msg.rx_len = 1;
-	msg.data[0] = PMBUS_VOUT_MODE;
-
-	if (i2c_master_read(&msg, retry)) {
+	if (pmbus_read_static_reg(cfg, PMBUS_VOUT_MODE, &vout_mode, 1)) {
 		return false;
 	}
 
-	*exponent = slinear11_exponents[msg.data[0] & 0x1f];
+	*exponent = slinear11_exponents[vout_mode & 0x1f];
 	return true;
 }
 
@@ -139,3 +180,336 @@ int pmbus_set_page(uint8_t bus, uint8_t addr, uint8_t page)
 	}
 	return ret;
 }
+
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+static pmbus_page_cache_entry *pmbus_page_cache_find(uint8_t bus, uint8_t addr, bool alloc)
+{
+	for (int i = 0; i < PMBUS_PAGE_CACHE_SIZE; i++) {
+		if (pmbus_page_cache[i].used && (pmbus_page_cache[i].bus == bus) &&
+		    (pmbus_page_cache[i].addr == addr)) {
+			return &pmbus_page_cache[i];
+		}
+	}
+
+	if (!alloc) {
+		return NULL;
+	}
+
+	// Reuse entries round robin once the table is full
+	pmbus_page_cache_entry *entry = &pmbus_page_cache[pmbus_page_cache_victim];
+	pmbus_page_cache_victim = (pmbus_page_cache_victim + 1) % PMBUS_PAGE_CACHE_SIZE;
+
+	entry->bus = bus;
+	entry->addr = addr;
+	entry->used = true;
+	entry->valid = false;
+	return entry;
+}
+
+static void pmbus_page_cache_store(uint8_t bus, uint8_t addr, uint8_t page)
+{
+	k_spinlock_key_t key = k_spin_lock(&pmbus_page_cache_lock);
+
+	pmbus_page_cache_entry *entry = pmbus_page_cache_find(bus, addr, true);
+	entry->page = page;
+	entry->valid = true;
+
+	k_spin_unlock(&pmbus_page_cache_lock, key);
+}
+
+static bool pmbus_page_cache_lookup(uint8_t bus, uint8_t addr, uint8_t *page)
+{
+	bool hit = false;
+	k_spinlock_key_t key = k_spin_lock(&pmbus_page_cache_lock);
+
+	pmbus_page_cache_entry *entry = pmbus_page_cache_find(bus, addr, false);
+	if ((entry != NULL) && entry->valid) {
+		*page = entry->page;
+		hit = true;
+	}
+
+	k_spin_unlock(&pmbus_page_cache_lock, key);
+	return hit;
+}
+#endif
+
+void pmbus_page_cache_invalidate(uint8_t bus, uint8_t addr)
+{
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	k_spinlock_key_t key = k_spin_lock(&pmbus_page_cache_lock);
+
+	pmbus_page_cache_entry *entry = pmbus_page_cache_find(bus, addr, false);
+	if (entry != NULL) {
+		entry->valid = false;
+	}
+
+	k_spin_unlock(&pmbus_page_cache_lock, key);
+#endif
+}
+
+/* Forget every device on a bus, its controller was reconfigured or had to recover the bus */
+void pmbus_page_cache_invalidate_bus(uint8_t bus)
+{
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	k_spinlock_key_t key = k_spin_lock(&pmbus_page_cache_lock);
+
+	for (int i = 0; i < PMBUS_PAGE_CACHE_SIZE; i++) {
+		if (pmbus_page_cache[i].bus == bus) {
+			pmbus_page_cache[i].valid = false;
+		}
+	}
+
+	k_spin_unlock(&pmbus_page_cache_lock, key);
+#endif
+}
+
+/* Devices lose their PAGE on power cycle, called on every DC power transition */
+void pmbus_page_cache_reset(void)
+{
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	k_spinlock_key_t key = k_spin_lock(&pmbus_page_cache_lock);
+
+	for (int i = 0; i < PMBUS_PAGE_CACHE_SIZE; i++) {
+		pmbus_page_cache[i].valid = false;
+	}
+
+	k_spin_unlock(&pmbus_page_cache_lock, key);
+#endif
+}
+
+#ifdef ENABLE_PMBUS_REG_CACHE
+static pmbus_reg_cache_entry *pmbus_reg_cache_find(const sensor_cfg *cfg, uint8_t reg)
+{
+	for (int i = 0; i < pmbus_reg_cache_count; i++) {
+		pmbus_reg_cache_entry *entry = &pmbus_reg_cache[i];
+		if ((entry->cfg == cfg) && (entry->reg == reg)) {
+			return entry;
+		}
+	}
+
+	return NULL;
+}
+
+static bool pmbus_reg_cache_lookup(const sensor_cfg *cfg, uint8_t reg, uint8_t *data, uint8_t len)
+{
+	bool hit = false;
+	k_spinlock_key_t key = k_spin_lock(&pmbus_reg_cache_lock);
+
+	pmbus_reg_cache_entry *entry = pmbus_reg_cache_find(cfg, reg);
+	if ((entry != NULL) && entry->valid && (entry->bus == cfg->port) &&
+	    (entry->addr == cfg->target_addr) && (entry->len == len)) {
+		memcpy(data, entry->data, len);
+		hit = true;
+	}
+
+	k_spin_unlock(&pmbus_reg_cache_lock, key);
+	return hit;
+}
+
+/* Make room for one more entry, the allocation happens outside the spinlock */
+static void pmbus_reg_cache_grow(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&pmbus_reg_cache_lock);
+	uint16_t old_size = pmbus_reg_cache_size;
+	k_spin_unlock(&pmbus_reg_cache_lock, key);
+
+	if (old_size > (UINT16_MAX / 2)) {
+		return;
+	}
+
+	uint16_t new_size = (old_size == 0) ? PMBUS_REG_CACHE_SIZE : (old_size * 2);
+	pmbus_reg_cache_entry *new_cache = malloc(new_size * sizeof(pmbus_reg_cache_entry));
+	if (new_cache == NULL) {
+		LOG_DBG("No memory to grow PMBus register cache to %d entries", new_size);
+		return;
+	}
+
+	pmbus_reg_cache_entry *old_cache = NULL;
+	key = k_spin_lock(&pmbus_reg_cache_lock);
+	if (pmbus_reg_cache_size == old_size) {
+		memcpy(new_cache, pmbus_reg_cache, pmbus_reg_cache_count * sizeof(*new_cache));
+		old_cache = pmbus_reg_cache;
+		pmbus_reg_cache = new_cache;
+		pmbus_reg_cache_size = new_size;
+		new_cache = NULL;
+	}
+	k_spin_unlock(&pmbus_reg_cache_lock, key);
+
+	// Either the replaced table or ours when another thread grew it first
+	SAFE_FREE(old_cache);
+	SAFE_FREE(new_cache);
+}
+
+static void pmbus_reg_cache_store(const sensor_cfg *cfg, uint8_t reg, const uint8_t *data,
+				  uint8_t len)
+{
+	for (int attempt = 0; attempt < 2; attempt++) {
+		k_spinlock_key_t key = k_spin_lock(&pmbus_reg_cache_lock);
+
+		pmbus_reg_cache_entry *entry = pmbus_reg_cache_find(cfg, reg);
+		if ((entry == NULL) && (pmbus_reg_cache_count < pmbus_reg_cache_size)) {
+			entry = &pmbus_reg_cache[pmbus_reg_cache_count++];
+		}
+
+		if (entry != NULL) {
+			entry->cfg = cfg;
+			entry->bus = cfg->port;
+			entry->addr = cfg->target_addr;
+			entry->reg = reg;
+			entry->len = len;
+			memcpy(entry->data, data, len);
+			entry->valid = true;
+			k_spin_unlock(&pmbus_reg_cache_lock, key);
+			return;
+		}
+
+		k_spin_unlock(&pmbus_reg_cache_lock, key);
+		pmbus_reg_cache_grow();
+	}
+
+	// Out of memory, the register is simply read from the device next time
+}
+
+static void pmbus_reg_cache_invalidate_reg(uint8_t bus, uint8_t addr, uint8_t reg)
+{
+	k_spinlock_key_t key = k_spin_lock(&pmbus_reg_cache_lock);
+
+	for (int i = 0; i < pmbus_reg_cache_count; i++) {
+		pmbus_reg_cache_entry *entry = &pmbus_reg_cache[i];
+		if ((entry->bus == bus) && (entry->addr == addr) && (entry->reg == reg)) {
+			entry->valid = false;
+		}
+	}
+
+	k_spin_unlock(&pmbus_reg_cache_lock, key);
+}
+#endif
+
+/* Drop every cached register of a device, drivers call this from init and after a VR update */
+void pmbus_reg_cache_invalidate(uint8_t bus, uint8_t addr)
+{
+#ifdef ENABLE_PMBUS_REG_CACHE
+	k_spinlock_key_t key = k_spin_lock(&pmbus_reg_cache_lock);
+
+	for (int i = 0; i < pmbus_reg_cache_count; i++) {
+		if ((pmbus_reg_cache[i].bus == bus) && (pmbus_reg_cache[i].addr == addr)) {
+			pmbus_reg_cache[i].valid = false;
+		}
+	}
+
+	k_spin_unlock(&pmbus_reg_cache_lock, key);
+#endif
+}
+
+/* Read a register whose value only changes on VR update or an explicit write.
+ * Entries are kept per sensor config entry: the pre-read hook puts each sensor on its own page.
+ */
+int pmbus_read_static_reg(const sensor_cfg *cfg, uint8_t reg, uint8_t *data, uint8_t len)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, -1);
+	CHECK_NULL_ARG_WITH_RETURN(data, -1);
+
+#ifdef ENABLE_PMBUS_REG_CACHE
+	if (len > PMBUS_REG_CACHE_DATA_MAX) {
+		return pmbus_read_command(cfg->port, cfg->target_addr, reg, data, len);
+	}
+
+	if (pmbus_reg_cache_lookup(cfg, reg, data, len)) {
+		return 0;
+	}
+
+	int ret = pmbus_read_command(cfg->port, cfg->target_addr, reg, data, len);
+	if (ret == 0) {
+		pmbus_reg_cache_store(cfg, reg, data, len);
+	}
+	return ret;
+#else
+	return pmbus_read_command(cfg->port, cfg->target_addr, reg, data, len);
+#endif
+}
+
+/* A timeout or arbitration loss makes the controller recover the bus, every device on it may
+ * have seen a truncated transfer. Anything else (NAK) only concerns the addressed device.
+ */
+static void pmbus_cache_track_error(uint8_t bus, uint8_t addr, int ret)
+{
+	if ((ret == -ETIMEDOUT) || (ret == -EBUSY) || (ret == -EAGAIN)) {
+		pmbus_page_cache_invalidate_bus(bus);
+	} else {
+		pmbus_page_cache_invalidate(bus, addr);
+	}
+}
+
+void pmbus_cache_track_write(uint8_t bus, uint8_t addr, const uint8_t *tx, uint8_t tx_len, int ret)
+{
+	if ((ret != 0) || (tx == NULL) || (tx_len == 0)) {
+		// The device state is unknown after a failed transfer
+		pmbus_cache_track_error(bus, addr, ret);
+		pmbus_reg_cache_invalidate(bus, addr);
+		return;
+	}
+
+	switch (tx[0]) {
+	case PMBUS_PAGE:
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+		if (tx_len == 2) {
+			pmbus_page_cache_store(bus, addr, tx[1]);
+		} else {
+			pmbus_page_cache_invalidate(bus, addr);
+		}
+#endif
+		break;
+	case PMBUS_RESTORE_DEFAULT_ALL:
+	case PMBUS_RESTORE_USER_ALL:
+		pmbus_page_cache_invalidate(bus, addr);
+		pmbus_reg_cache_invalidate(bus, addr);
+		break;
+	default:
+#ifdef ENABLE_PMBUS_REG_CACHE
+		pmbus_reg_cache_invalidate_reg(bus, addr, tx[0]);
+#endif
+		break;
+	}
+}
+
+void pmbus_cache_track_read(uint8_t bus, uint8_t addr, const uint8_t *tx, uint8_t tx_len,
+			    const uint8_t *rx, int ret)
+{
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	if (ret != 0) {
+		pmbus_cache_track_error(bus, addr, ret);
+		return;
+	}
+
+	if ((tx != NULL) && (rx != NULL) && (tx_len == 1) && (tx[0] == PMBUS_PAGE)) {
+		pmbus_page_cache_store(bus, addr, rx[0]);
+	}
+#endif
+}
+
+/* Same as pmbus_set_page but skips the write when the device is known to be on the page */
+int pmbus_select_page(uint8_t bus, uint8_t addr, uint8_t page)
+{
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	uint8_t current_page = 0;
+
+	if (pmbus_page_cache_lookup(bus, addr, &current_page) && (current_page == page)) {
+		return 0;
+	}
+#endif
+
+	return pmbus_set_page(bus, addr, page);
+}
+
+int pmbus_get_page(uint8_t bus, uint8_t addr, uint8_t *page)
+{
+	CHECK_NULL_ARG_WITH_RETURN(page, -1);
+
+#ifdef ENABLE_PMBUS_PAGE_CACHE
+	if (pmbus_page_cache_lookup(bus, addr, page)) {
+		return 0;
+	}
+#endif
+
+	return pmbus_read_command(bus, addr, PMBUS_PAGE, page, 1);
+}
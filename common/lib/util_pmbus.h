@@ -19,10 +19,26 @@
 
 #include "sensor.h"
 
+/* Devices whose PMBus PAGE is remembered, see ENABLE_PMBUS_PAGE_CACHE */
+#define PMBUS_PAGE_CACHE_SIZE_DEFAULT 32
+/* Initial static register entries, see ENABLE_PMBUS_REG_CACHE. The table grows on demand. */
+#define PMBUS_REG_CACHE_SIZE_DEFAULT 64
+#define PMBUS_REG_CACHE_DATA_MAX 2
+
 float slinear11_to_float(uint16_t);
 bool get_exponent_from_vout_mode(sensor_cfg *, float *);
 int pmbus_read_command(uint8_t bus, uint8_t addr, uint8_t command, uint8_t *result,
 		       uint8_t read_len);
 int pmbus_set_page(uint8_t bus, uint8_t addr, uint8_t page);
+int pmbus_select_page(uint8_t bus, uint8_t addr, uint8_t page);
+int pmbus_get_page(uint8_t bus, uint8_t addr, uint8_t *page);
+void pmbus_page_cache_invalidate(uint8_t bus, uint8_t addr);
+void pmbus_page_cache_invalidate_bus(uint8_t bus);
+void pmbus_page_cache_reset(void);
+int pmbus_read_static_reg(const sensor_cfg *cfg, uint8_t reg, uint8_t *data, uint8_t len);
+void pmbus_reg_cache_invalidate(uint8_t bus, uint8_t addr);
+void pmbus_cache_track_write(uint8_t bus, uint8_t addr, const uint8_t *tx, uint8_t tx_len, int ret);
+void pmbus_cache_track_read(uint8_t bus, uint8_t addr, const uint8_t *tx, uint8_t tx_len,
+			    const uint8_t *rx, int ret);
 
 #endif
@@ -393,10 +393,9 @@ static bool ssif_data_handle(ssif_dev *ssif_inst, ssif_action_t action, uint8_t
 			if (skip_ipmi_handle)
 				goto exit;
 
-			while (k_msgq_put(&ipmi_msgq, &ssif_inst->current_ipmi_msg, K_NO_WAIT) !=
-			       0) {
-				k_msgq_purge(&ipmi_msgq);
-				LOG_WRN("SSIF[%d] retrying put ipmi msgq", ssif_inst->index);
+			/* Answered node busy by ipmi when it cannot take the request */
+			if (notify_ipmi_client(&ssif_inst->current_ipmi_msg) != IPMB_ERROR_SUCCESS) {
+				LOG_WRN("SSIF[%d] ipmi msgq rejected request", ssif_inst->index);
 			}
 			/* Message to BMC */
 		} else {
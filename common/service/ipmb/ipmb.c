@@ -50,16 +50,11 @@ LOG_MODULE_REGISTER(ipmb);
 #if MAX_IPMB_IDX
 
 static struct k_mutex mutex_id[MAX_IPMB_IDX]; // mutex for sequence linked list insert/find
-static struct k_mutex mutex_send_req[MAX_IPMB_IDX], mutex_send_res, mutex_read;
+static struct k_mutex mutex_send_req[MAX_IPMB_IDX], mutex_send_res;
 static const struct device *dev_ipmb[I2C_BUS_MAX_NUM];
 
 char __aligned(4) ipmb_txqueue_buffer[MAX_IPMB_IDX][IPMB_TXQUEUE_LEN * sizeof(struct ipmi_msg_cfg)];
-char __aligned(4) ipmb_rxqueue_buffer[MAX_IPMB_IDX][IPMB_RXQUEUE_LEN * sizeof(struct ipmi_msg)];
 struct k_msgq ipmb_txqueue[MAX_IPMB_IDX];
-struct k_msgq ipmb_rxqueue[MAX_IPMB_IDX];
-
-struct k_thread IPMB_SeqTimeout;
-K_KERNEL_STACK_MEMBER(IPMB_SeqTimeout_stack, IPMB_SEQ_TIMEOUT_STACK_SIZE);
 
 K_THREAD_STACK_EXTERN(ipmb_rx_stack);
 K_THREAD_STACK_EXTERN(ipmb_tx_stack);
@@ -72,15 +67,188 @@ static k_tid_t IPMB_TX_ID[MAX_IPMB_IDX];
 static bool ipmb_tx_disable[MAX_IPMB_IDX];
 
 IPMB_config *IPMB_config_table;
-ipmi_msg_cfg *P_start[MAX_IPMB_IDX],
-	*P_temp; // pointer for sequence queue(link list)
-static unsigned int seq_current_count[MAX_IPMB_IDX] = { 0 };
-static uint32_t tick_fix;
-static uint32_t sys_tick_freq;
 
 static uint8_t current_seq[MAX_IPMB_IDX]; // Sequence in BIC for sending
 	// sequence to other IPMB devices
-static bool seq_table[MAX_IPMB_IDX][SEQ_NUM]; // Sequence table in BIC for register record
+/* Outstanding requests sent by BIC, indexed by the sequence number they went out with */
+typedef struct ipmb_seq_entry {
+	struct k_work_delayable expire_work;
+	int64_t deadline;
+	uint8_t index;
+	uint8_t seq;
+	bool used;
+	uint8_t netfn;
+	uint8_t cmd;
+	uint8_t seq_source;
+	uint8_t pldm_inst_id;
+	uint8_t InF_source;
+	uint8_t InF_target;
+} ipmb_seq_entry;
+
+static ipmb_seq_entry seq_table[MAX_IPMB_IDX][SEQ_NUM];
+
+/* Callers blocked in ipmb_read, keyed by the sequence number their request went out with */
+typedef struct ipmb_seq_waiter {
+	struct k_sem done;
+	ipmi_msg *resp;
+	ipmb_error ret;
+	bool armed;
+} ipmb_seq_waiter;
+
+static ipmb_seq_waiter seq_waiter[MAX_IPMB_IDX][SEQ_NUM];
+static struct k_mutex mutex_waiter[MAX_IPMB_IDX];
+
+/*
+ * Fixed-size blocks used by the TX/RX paths. With ENABLE_IPMB_MEM_POOL they come from slabs
+ * sized per MAX_IPMB_IDX at build time so message handling never touches the heap, otherwise
+ * they fall back to malloc. Usage is tracked in both cases for the shell.
+ */
+#define IPMB_RX_BUFF_SIZE ROUND_UP(IPMI_MSG_MAX_LENGTH + IPMB_RESP_HEADER_LENGTH, 4)
+/* One TX and one RX working message per index */
+#define IPMB_POOL_MSG_CFG_NUM (MAX_IPMB_IDX * 2)
+#define IPMB_POOL_RX_BUFF_NUM MAX_IPMB_IDX
+#define IPMB_POOL_I2C_MSG_NUM MAX_IPMB_IDX
+#define IPMB_POOL_BRIDGE_MSG_NUM MAX_IPMB_IDX
+#define IPMB_POOL_KCS_BUFF_NUM (MAX_IPMB_IDX * 2)
+#define IPMB_POOL_ALLOC_TIMEOUT_MS 10
+
+enum IPMB_POOL_ID {
+	IPMB_POOL_MSG_CFG = 0,
+	IPMB_POOL_RX_BUFF,
+	IPMB_POOL_I2C_MSG,
+	IPMB_POOL_BRIDGE_MSG,
+#ifdef CONFIG_IPMI_KCS_ASPEED
+	IPMB_POOL_KCS_BUFF,
+#endif
+	IPMB_POOL_MAX,
+};
+
+#ifdef ENABLE_IPMB_MEM_POOL
+K_MEM_SLAB_DEFINE(ipmb_msg_cfg_slab, ROUND_UP(sizeof(ipmi_msg_cfg), 4), IPMB_POOL_MSG_CFG_NUM, 4);
+K_MEM_SLAB_DEFINE(ipmb_rx_buff_slab, IPMB_RX_BUFF_SIZE, IPMB_POOL_RX_BUFF_NUM, 4);
+K_MEM_SLAB_DEFINE(ipmb_i2c_msg_slab, ROUND_UP(sizeof(I2C_MSG), 4), IPMB_POOL_I2C_MSG_NUM, 4);
+K_MEM_SLAB_DEFINE(ipmb_bridge_msg_slab, ROUND_UP(sizeof(ipmi_msg), 4), IPMB_POOL_BRIDGE_MSG_NUM,
+		  4);
+#ifdef CONFIG_IPMI_KCS_ASPEED
+K_MEM_SLAB_DEFINE(ipmb_kcs_buff_slab, ROUND_UP(KCS_BUFF_SIZE, 4), IPMB_POOL_KCS_BUFF_NUM, 4);
+#endif
+#define IPMB_POOL_SLAB(slab) (&(slab))
+#define IPMB_POOL_NUM(num) (num)
+#else
+#define IPMB_POOL_SLAB(slab) NULL
+#define IPMB_POOL_NUM(num) 0
+#endif
+
+typedef struct ipmb_pool {
+	struct k_mem_slab *slab;
+	ipmb_pool_stat stat;
+} ipmb_pool;
+
+#define IPMB_POOL_ENTRY(slab, name, size, num)                                                     \
+	{                                                                                          \
+		IPMB_POOL_SLAB(slab), { name, size, IPMB_POOL_NUM(num) }                           \
+	}
+
+static ipmb_pool ipmb_pools[IPMB_POOL_MAX] = {
+	[IPMB_POOL_MSG_CFG] = IPMB_POOL_ENTRY(ipmb_msg_cfg_slab, "msg_cfg", sizeof(ipmi_msg_cfg),
+					      IPMB_POOL_MSG_CFG_NUM),
+	[IPMB_POOL_RX_BUFF] = IPMB_POOL_ENTRY(ipmb_rx_buff_slab, "rx_buff", IPMB_RX_BUFF_SIZE,
+					      IPMB_POOL_RX_BUFF_NUM),
+	[IPMB_POOL_I2C_MSG] = IPMB_POOL_ENTRY(ipmb_i2c_msg_slab, "i2c_msg", sizeof(I2C_MSG),
+					      IPMB_POOL_I2C_MSG_NUM),
+	[IPMB_POOL_BRIDGE_MSG] = IPMB_POOL_ENTRY(ipmb_bridge_msg_slab, "bridge_msg",
+						 sizeof(ipmi_msg), IPMB_POOL_BRIDGE_MSG_NUM),
+#ifdef CONFIG_IPMI_KCS_ASPEED
+	[IPMB_POOL_KCS_BUFF] = IPMB_POOL_ENTRY(ipmb_kcs_buff_slab, "kcs_buff", KCS_BUFF_SIZE,
+					       IPMB_POOL_KCS_BUFF_NUM),
+#endif
+};
+static struct k_spinlock ipmb_pool_lock;
+
+/* Same contract as malloc, but waits up to timeout for a free block before giving up */
+static void *ipmb_pool_alloc(uint8_t pool_id, k_timeout_t timeout)
+{
+	ipmb_pool *pool = &ipmb_pools[pool_id];
+	void *block = NULL;
+
+#ifdef ENABLE_IPMB_MEM_POOL
+	if (k_mem_slab_alloc(pool->slab, &block, timeout) != 0) {
+		block = NULL;
+	}
+#else
+	block = malloc(pool->stat.block_size);
+	if ((block == NULL) && !K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		k_sleep(timeout);
+		block = malloc(pool->stat.block_size);
+	}
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&ipmb_pool_lock);
+	if (block != NULL) {
+		pool->stat.used++;
+		if (pool->stat.used > pool->stat.max_used) {
+			pool->stat.max_used = pool->stat.used;
+		}
+	} else {
+		pool->stat.alloc_fail++;
+	}
+	k_spin_unlock(&ipmb_pool_lock, key);
+
+	return block;
+}
+
+static void ipmb_pool_free(uint8_t pool_id, void *block)
+{
+	if (block == NULL) {
+		return;
+	}
+
+	ipmb_pool *pool = &ipmb_pools[pool_id];
+#ifdef ENABLE_IPMB_MEM_POOL
+	k_mem_slab_free(pool->slab, &block);
+#else
+	free(block);
+#endif
+
+	k_spinlock_key_t key = k_spin_lock(&ipmb_pool_lock);
+	pool->stat.used--;
+	k_spin_unlock(&ipmb_pool_lock, key);
+}
+
+#define IPMB_POOL_FREE(pool_id, p)                                                                 \
+	if (p) {                                                                                   \
+		ipmb_pool_free(pool_id, p);                                                        \
+		p = NULL;                                                                          \
+	}
+
+/* Per-index RX task counters, updated only by the owning IPMB_RXTask */
+static ipmb_rx_stat ipmb_rx_stats[MAX_IPMB_IDX];
+
+bool ipmb_get_rx_stat(uint8_t index, ipmb_rx_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	if (index >= MAX_IPMB_IDX) {
+		return false;
+	}
+
+	memcpy(stat, &ipmb_rx_stats[index], sizeof(ipmb_rx_stat));
+	return true;
+}
+
+bool ipmb_get_pool_stat(uint8_t pool_id, ipmb_pool_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	if (pool_id >= IPMB_POOL_MAX) {
+		return false;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&ipmb_pool_lock);
+	memcpy(stat, &ipmb_pools[pool_id].stat, sizeof(ipmb_pool_stat));
+	k_spin_unlock(&ipmb_pool_lock, key);
+	return true;
+}
 
 ipmb_error validate_checksum(uint8_t *buffer, uint8_t buffer_len);
 ipmb_error ipmb_encode(uint8_t *buffer, ipmi_msg *msg);
@@ -139,14 +307,49 @@ ipmb_error validate_checksum(uint8_t *buffer, uint8_t buffer_len)
 	return IPMB_ERROR_MSG_CHECKSUM;
 }
 
-void unregister_seq(uint8_t index, uint8_t seq_num)
+/* Caller holds mutex_id[index] */
+static void unregister_seq(uint8_t index, uint8_t seq_num)
 {
-	seq_table[index][seq_num] = 0;
+	seq_table[index][seq_num].used = false;
+	k_work_cancel_delayable(&seq_table[index][seq_num].expire_work);
 }
 
-void register_seq(uint8_t index, uint8_t seq_num)
+/* Caller holds mutex_id[index] */
+static void register_seq(uint8_t index, ipmi_msg *msg)
 {
-	seq_table[index][seq_num] = 1;
+	ipmb_seq_entry *entry = &seq_table[index][msg->seq_target];
+
+	entry->netfn = msg->netfn;
+	entry->cmd = msg->cmd;
+	entry->seq_source = msg->seq_source;
+	entry->pldm_inst_id = msg->pldm_inst_id;
+	entry->InF_source = msg->InF_source;
+	entry->InF_target = msg->InF_target;
+	entry->deadline = k_uptime_get() + IPMB_SEQ_TIMEOUT_MS;
+	entry->used = true;
+	k_work_reschedule(&entry->expire_work, K_MSEC(IPMB_SEQ_TIMEOUT_MS));
+}
+
+/* Reap a request nobody answered, exactly at its deadline */
+static void seq_expire_handler(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	ipmb_seq_entry *entry = CONTAINER_OF(dwork, ipmb_seq_entry, expire_work);
+
+	if (k_mutex_lock(&mutex_id[entry->index], K_MSEC(1000))) {
+		LOG_ERR("Failed to lock the mutex id%d", entry->index);
+		k_work_reschedule(dwork, K_MSEC(IPMB_POLLING_TIME_MS));
+		return;
+	}
+
+	// The entry may have been answered and reused after this expiry was scheduled
+	if (entry->used && (k_uptime_get() >= entry->deadline)) {
+		LOG_DBG("IPMB[%d] seq(%d) netfn(0x%x) cmd(0x%x) timeout", entry->index, entry->seq,
+			entry->netfn, entry->cmd);
+		entry->used = false;
+	}
+
+	k_mutex_unlock(&mutex_id[entry->index]);
 }
 
 uint8_t get_free_seq(uint8_t index)
@@ -155,7 +358,8 @@ uint8_t get_free_seq(uint8_t index)
 
 	do {
 		current_seq[index] = (current_seq[index] + 1) & 0x3f;
-		if (!seq_table[index][current_seq[index]]) {
+		if (!seq_table[index][current_seq[index]].used &&
+		    !seq_waiter[index][current_seq[index]].armed) {
 			break;
 		}
 
@@ -169,159 +373,122 @@ uint8_t get_free_seq(uint8_t index)
 	return current_seq[index];
 }
 
-/* Record IPMB request for checking response sequence and finding source
- * sequence for bridge command */
-void insert_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
+static void arm_seq_waiter(uint8_t index, uint8_t seq_num, ipmi_msg *resp)
 {
-	CHECK_NULL_ARG(pnode);
-	CHECK_NULL_ARG(msg);
+	ipmb_seq_waiter *waiter = &seq_waiter[index][seq_num];
+
+	k_mutex_lock(&mutex_waiter[index], K_FOREVER);
+	k_sem_reset(&waiter->done);
+	waiter->resp = resp;
+	waiter->ret = IPMB_ERROR_UNKNOWN;
+	waiter->armed = true;
+	k_mutex_unlock(&mutex_waiter[index]);
+}
 
-	ipmi_msg_cfg *ptr_start = pnode;
-	int ret;
+/* Returns true if the waiter was still armed, false if it already completed */
+static bool disarm_seq_waiter(uint8_t index, uint8_t seq_num)
+{
+	ipmb_seq_waiter *waiter = &seq_waiter[index][seq_num];
+	bool armed;
 
-	ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
-	if (ret) {
-		LOG_ERR("Failed to lock the mutex(%d)", ret);
-		return;
-	} else {
-		// No more room, remove the first node.
-		if (seq_current_count[index] == MAX_SEQ_QUENE) {
-			ipmi_msg_cfg *temp;
-			temp = pnode->next;
-			if (temp == NULL) {
-				LOG_ERR("Not a circular linked list");
-				k_mutex_unlock(&mutex_id[index]);
-				return;
-			}
-			pnode->next = temp->next;
-			SAFE_FREE(temp);
-			seq_current_count[index]--;
-		}
+	k_mutex_lock(&mutex_waiter[index], K_FOREVER);
+	armed = waiter->armed;
+	waiter->armed = false;
+	waiter->resp = NULL;
+	k_mutex_unlock(&mutex_waiter[index]);
 
-		while (pnode && pnode->next != ptr_start) {
-			pnode = pnode->next;
-		}
+	return armed;
+}
 
-		if (pnode == NULL) {
-			LOG_ERR("Not a circular linked list");
-			k_mutex_unlock(&mutex_id[index]);
-			return;
-		}
+/* Hand a response (or a failure when resp is NULL) straight to the caller waiting on seq_num */
+static bool complete_seq_waiter(uint8_t index, uint8_t seq_num, ipmi_msg *resp, ipmb_error ret)
+{
+	if ((index >= MAX_IPMB_IDX) || (seq_num >= SEQ_NUM)) {
+		return false;
+	}
 
-		/* Allocate memory for the new node and put data in it.*/
-		pnode->next = malloc(sizeof(ipmi_msg_cfg));
-		if (pnode->next == NULL) {
-			k_mutex_unlock(&mutex_id[index]);
-			return;
+	ipmb_seq_waiter *waiter = &seq_waiter[index][seq_num];
+	bool armed;
+
+	k_mutex_lock(&mutex_waiter[index], K_FOREVER);
+	armed = waiter->armed;
+	if (armed) {
+		if (resp != NULL) {
+			memcpy(waiter->resp, resp, sizeof(ipmi_msg));
 		}
-		pnode = pnode->next;
+		waiter->ret = ret;
+		waiter->armed = false;
+		waiter->resp = NULL;
+		k_sem_give(&waiter->done);
+	}
+	k_mutex_unlock(&mutex_waiter[index]);
 
-		msg->timestamp = osKernelGetSysTimerCount();
-		memcpy(&pnode->buffer, msg, sizeof(ipmi_msg));
-		register_seq(index, pnode->buffer.seq_target);
+	return armed;
+}
 
-		pnode->next = ptr_start;
-		seq_current_count[index]++;
-		k_mutex_unlock(&mutex_id[index]);
+/* Record IPMB request for checking response sequence and finding source
+ * sequence for bridge command */
+void insert_req_ipmi_msg(ipmi_msg *msg, uint8_t index)
+{
+	CHECK_NULL_ARG(msg);
+
+	int ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
+	if (ret) {
+		LOG_ERR("Failed to lock the mutex(%d)", ret);
 		return;
 	}
+
+	register_seq(index, msg);
+
+	k_mutex_unlock(&mutex_id[index]);
 }
 
 /* Find if any IPMB request record match receiving response */
-bool find_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
+bool find_req_ipmi_msg(ipmi_msg *msg, uint8_t index)
 {
-	CHECK_NULL_ARG_WITH_RETURN(pnode, false);
 	CHECK_NULL_ARG_WITH_RETURN(msg, false);
 
-	ipmi_msg_cfg *ptr_start = pnode;
-	int ret;
-
-	ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
+	int ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
 	if (ret) {
 		LOG_ERR("Failed to lock the mutex(%d)", ret);
 		return false;
 	}
 
-	while ((pnode != NULL && pnode->next != ptr_start) &&
-	       (((pnode->next)->buffer.netfn != (msg->netfn & (~0x01))) ||
-		((pnode->next)->buffer.cmd != msg->cmd) ||
-		((pnode->next)->buffer.seq_target != msg->seq_target))) {
-		pnode = pnode->next;
-	}
-
-	if (pnode == NULL) {
-		LOG_ERR("pnode list should be circular, list end found");
-		k_mutex_unlock(&mutex_id[index]);
-		return false;
-	}
-
-	if (pnode->next == ptr_start) {
+	ipmb_seq_entry *entry = &seq_table[index][msg->seq_target & (SEQ_NUM - 1)];
+	if (!entry->used || (entry->netfn != (msg->netfn & (~0x01))) || (entry->cmd != msg->cmd)) {
 		LOG_ERR("no req match recv resp");
-		LOG_ERR("node netfn: %x,cmd: %x, seq_t: %x", (pnode->next)->buffer.netfn,
-			(pnode->next)->buffer.cmd, (pnode->next)->buffer.seq_target);
+		LOG_ERR("entry used: %d, netfn: %x, cmd: %x, seq_t: %x", entry->used, entry->netfn,
+			entry->cmd, msg->seq_target);
 		LOG_ERR("msg netfn: %x,cmd: %x, seq_t: %x", msg->netfn, msg->cmd, msg->seq_target);
 		k_mutex_unlock(&mutex_id[index]);
 		return false;
 	}
 
-	/* Now pointer points to a node and the node next to it has to be removed */
-	ipmi_msg_cfg *temp;
-	temp = pnode->next;
-
-	if (temp == NULL) {
-		LOG_ERR("pnode list should be circular, list end found");
-		k_mutex_unlock(&mutex_id[index]);
-		return false;
-	}
-
 	// find source sequence for responding
-	msg->seq_source = temp->buffer.seq_source;
-	unregister_seq(index, temp->buffer.seq_target);
-
-	msg->pldm_inst_id = temp->buffer.pldm_inst_id;
-	msg->InF_source = temp->buffer.InF_source;
-	msg->InF_target = temp->buffer.InF_target;
-	/*temp points to the node which has to be removed*/
-	pnode->next = temp->next;
-	/*We removed the node which is next to the pointer (which is also temp) */
-
-	/* Because we deleted the node, we no longer require the memory used for it
-   * free() will deallocate the memory.
-   */
-	SAFE_FREE(temp);
-	seq_current_count[index]--;
+	msg->seq_source = entry->seq_source;
+	msg->pldm_inst_id = entry->pldm_inst_id;
+	msg->InF_source = entry->InF_source;
+	msg->InF_target = entry->InF_target;
+	unregister_seq(index, entry->seq);
 
 	k_mutex_unlock(&mutex_id[index]);
 	return true;
 }
 
-void clear_req_ipmi_msg(ipmi_msg_cfg *pnode, ipmi_msg *msg, uint8_t index)
+void clear_req_ipmi_msg(ipmi_msg *msg, uint8_t index)
 {
-	CHECK_NULL_ARG(pnode);
 	CHECK_NULL_ARG(msg);
 
-	int ret = 0;
-
-	// Mutex for request sequence linked list change
-	ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
+	// Mutex for request sequence table change
+	int ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
 	if (ret) {
 		LOG_ERR("Failed to lock the mutex id%d, ret%d", index, ret);
 		return;
 	}
 
-	ipmi_msg_cfg *temp = NULL;
-	while (pnode->next != P_start[index]) {
-		temp = pnode->next;
-		if ((temp->buffer.netfn == msg->netfn) && (temp->buffer.cmd == msg->cmd) &&
-		    (temp->buffer.seq == msg->seq)) {
-			pnode->next = temp->next;
-			unregister_seq(index, temp->buffer.seq_target);
-			SAFE_FREE(temp);
-			seq_current_count[index]--;
-			break;
-		}
-
-		pnode = pnode->next;
+	ipmb_seq_entry *entry = &seq_table[index][msg->seq & (SEQ_NUM - 1)];
+	if (entry->used && (entry->netfn == msg->netfn) && (entry->cmd == msg->cmd)) {
+		unregister_seq(index, entry->seq);
 	}
 
 	k_mutex_unlock(&mutex_id[index]);
@@ -374,9 +541,9 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 	memcpy(&ipmb_cfg, (IPMB_config *)pvParameters, sizeof(IPMB_config));
 
 	while (1) {
-		current_msg_tx = (struct ipmi_msg_cfg *)malloc(sizeof(struct ipmi_msg_cfg));
+		current_msg_tx = (struct ipmi_msg_cfg *)ipmb_pool_alloc(
+			IPMB_POOL_MSG_CFG, K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
 		if (current_msg_tx == NULL) {
-			k_msleep(10);
 			continue;
 		}
 
@@ -401,16 +568,8 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 			uint8_t resp_tx_size =
 				current_msg_tx->buffer.data_len + IPMB_RESP_HEADER_LENGTH;
 			if (ipmb_cfg.interface == I2C_IF) {
-				int retry = 0;
-				do {
-					i2c_msg = malloc(sizeof(I2C_MSG));
-					if (i2c_msg == NULL) {
-						k_msleep(10);
-					} else {
-						break;
-					}
-					retry++;
-				} while (retry < MEM_ALLOCATE_RETRY_TIME);
+				i2c_msg = ipmb_pool_alloc(IPMB_POOL_I2C_MSG,
+							  K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
 				if (i2c_msg == NULL) {
 					LOG_ERR("Failed to allocate memory for I2C resp msg");
 					goto cleanup;
@@ -422,7 +581,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 				memcpy(&i2c_msg->data[0], &ipmb_buffer_tx[1], resp_tx_size);
 
 				ret = i2c_master_write(i2c_msg, I2C_RETRY_TIME);
-				SAFE_FREE(i2c_msg);
+				IPMB_POOL_FREE(IPMB_POOL_I2C_MSG, i2c_msg);
 			} else {
 				LOG_ERR("Unsupported interface(%d) for index(%d)",
 					ipmb_cfg.interface, ipmb_cfg.index);
@@ -461,16 +620,8 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 				current_msg_tx->buffer.data_len + IPMB_REQ_HEADER_LENGTH;
 
 			if (ipmb_cfg.interface == I2C_IF) {
-				int retry = 0;
-				do {
-					i2c_msg = malloc(sizeof(I2C_MSG));
-					if (i2c_msg == NULL) {
-						k_msleep(10);
-					} else {
-						break;
-					}
-					retry++;
-				} while (retry < MEM_ALLOCATE_RETRY_TIME);
+				i2c_msg = ipmb_pool_alloc(IPMB_POOL_I2C_MSG,
+							  K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
 				if (i2c_msg == NULL) {
 					LOG_ERR("Failed to allocate memory for I2C resp msg");
 					goto cleanup;
@@ -482,8 +633,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 				memcpy(&i2c_msg->data[0], &ipmb_buffer_tx[1], req_tx_size);
 
 				current_msg_tx->buffer.seq_target = current_msg_tx->buffer.seq;
-				insert_req_ipmi_msg(P_start[ipmb_cfg.index],
-						    &current_msg_tx->buffer, ipmb_cfg.index);
+				insert_req_ipmi_msg(&current_msg_tx->buffer, ipmb_cfg.index);
 				if (DEBUG_IPMB) {
 					LOG_DBG("Send a request message, from(%d) to(%d) netfn(0x%x) cmd(0x%x) CC(0x%x)",
 						current_msg_tx->buffer.InF_source,
@@ -501,7 +651,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 				}
 
 				ret = i2c_master_write(i2c_msg, I2C_RETRY_TIME);
-				SAFE_FREE(i2c_msg);
+				IPMB_POOL_FREE(IPMB_POOL_I2C_MSG, i2c_msg);
 			} else {
 				LOG_ERR("Unsupported interface(%d) for index(%d)",
 					ipmb_cfg.interface, ipmb_cfg.index);
@@ -509,8 +659,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 			}
 
 			if (ret) {
-				find_req_ipmi_msg(P_start[ipmb_cfg.index],
-						  &(current_msg_tx->buffer), ipmb_cfg.index);
+				find_req_ipmi_msg(&(current_msg_tx->buffer), ipmb_cfg.index);
 
 				current_msg_tx->retries += 1;
 
@@ -519,6 +668,9 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 						LOG_ERR("The request message is from RESERVED");
 					} else if (current_msg_tx->buffer.InF_source == SELF) {
 						LOG_ERR("Failed to send command");
+						complete_seq_waiter(ipmb_cfg.index,
+								    current_msg_tx->buffer.seq,
+								    NULL, IPMB_ERROR_FAILURE);
 					} else if (current_msg_tx->buffer.InF_source == MPRO_PLDM) {
 #ifdef ENABLE_MPRO
 						LOG_ERR("Failed to send command from Mpro");
@@ -528,17 +680,14 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 						// the source is KCS if the bit[7:4] are 0101b.
 #ifdef CONFIG_IPMI_KCS_ASPEED
 						uint8_t *kcs_buff;
-						kcs_buff = malloc(KCS_BUFF_SIZE * sizeof(uint8_t));
-						if (kcs_buff ==
-						    NULL) { // allocate fail, retry allocate
-							k_msleep(10);
-							kcs_buff = malloc(KCS_BUFF_SIZE *
-									  sizeof(uint8_t));
-							if (kcs_buff == NULL) {
-								LOG_ERR("IPMB_TXTask: Fail to malloc for kcs_buff");
-								SAFE_FREE(current_msg_tx);
-								continue;
-							}
+						kcs_buff = ipmb_pool_alloc(
+							IPMB_POOL_KCS_BUFF,
+							K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
+						if (kcs_buff == NULL) {
+							LOG_ERR("IPMB_TXTask: Fail to malloc for kcs_buff");
+							IPMB_POOL_FREE(IPMB_POOL_MSG_CFG,
+								       current_msg_tx);
+							continue;
 						}
 						current_msg_tx->buffer.completion_code =
 							CC_CAN_NOT_RESPOND;
@@ -557,7 +706,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 								  HOST_KCS_1,
 							  kcs_buff,
 							  current_msg_tx->buffer.data_len + 3);
-						SAFE_FREE(kcs_buff);
+						IPMB_POOL_FREE(IPMB_POOL_KCS_BUFF, kcs_buff);
 #endif
 					} else {
 						// Return the error code(node busy) to the source channel
@@ -599,7 +748,7 @@ void IPMB_TXTask(void *pvParameters, void *arvg0, void *arvg1)
 		}
 
 	cleanup:
-		SAFE_FREE(current_msg_tx);
+		IPMB_POOL_FREE(IPMB_POOL_MSG_CFG, current_msg_tx);
 		k_msleep(IPMB_POLLING_TIME_MS);
 	}
 }
@@ -623,23 +772,24 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 	}
 
 	while (1) {
-		current_msg_rx = (struct ipmi_msg_cfg *)malloc(sizeof(struct ipmi_msg_cfg));
+		current_msg_rx = (struct ipmi_msg_cfg *)ipmb_pool_alloc(
+			IPMB_POOL_MSG_CFG, K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
 		if (current_msg_rx == NULL) {
-			k_msleep(10); // allocate fail, retry later
-			continue;
+			continue; // allocate fail, retry later
 		}
 		ipmb_buffer_rx =
-			malloc((IPMI_MSG_MAX_LENGTH + IPMB_RESP_HEADER_LENGTH) * sizeof(uint8_t));
+			ipmb_pool_alloc(IPMB_POOL_RX_BUFF, K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
 		if (ipmb_buffer_rx == NULL) {
-			SAFE_FREE(current_msg_rx);
-			k_msleep(10); // allocate fail, retry later
-			continue;
+			IPMB_POOL_FREE(IPMB_POOL_MSG_CFG, current_msg_rx);
+			continue; // allocate fail, retry later
 		}
 
 		rx_len = 0;
+		ipmb_rx_stats[ipmb_cfg.index].wakeup_cnt++;
 		if (ipmb_cfg.interface == I2C_IF) {
 			ret = ipmb_slave_read(dev_ipmb[ipmb_cfg.bus], &ipmb_msg, &rx_len);
 			if (!ret) {
+				ipmb_rx_stats[ipmb_cfg.index].frame_cnt++;
 				memcpy(ipmb_buffer_rx, (uint8_t *)ipmb_msg, rx_len);
 				ipmb_buffer_rx[0] = ipmb_buffer_rx[0] >> 1;
 			} else {
@@ -688,8 +838,7 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 			if (IS_RESPONSE(current_msg_rx->buffer)) { // Response message
 				/* Find the corresponding request message*/
 				current_msg_rx->buffer.seq_target = current_msg_rx->buffer.seq;
-				if (find_req_ipmi_msg(P_start[ipmb_cfg.index],
-						      &(current_msg_rx->buffer), ipmb_cfg.index)) {
+				if (find_req_ipmi_msg(&(current_msg_rx->buffer), ipmb_cfg.index)) {
 					if (DEBUG_IPMB) {
 						LOG_DBG("Found the corresponding request message, from(0x%x) to(0x%x) target_seq_num(%d)",
 							current_msg_rx->buffer.InF_source,
@@ -699,14 +848,15 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 
 					if (current_msg_rx->buffer.InF_source ==
 					    SELF) { // Send from other thread
-						struct ipmi_msg current_msg;
-						current_msg =
-							(struct ipmi_msg)current_msg_rx->buffer;
-						k_msgq_put(
-							&ipmb_rxqueue[IPMB_inf_index_map
-									      [current_msg_rx->buffer
-										       .InF_target]],
-							&current_msg, K_NO_WAIT);
+						// Caller waits on the index the request matched
+						if (!complete_seq_waiter(
+							    ipmb_cfg.index,
+							    current_msg_rx->buffer.seq_target,
+							    &current_msg_rx->buffer,
+							    IPMB_ERROR_SUCCESS)) {
+							LOG_DBG("No caller for seq(%d)",
+								current_msg_rx->buffer.seq_target);
+						}
 					} else if ((current_msg_rx->buffer.InF_source & 0xF0) ==
 						   HOST_KCS_1) {
 						// the source is KCS if the bit[7:4] are 0101b.
@@ -717,17 +867,9 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 							goto cleanup;
 						}
 						uint8_t *kcs_buff;
-						int retry = 0;
-						do {
-							kcs_buff = malloc(KCS_BUFF_SIZE *
-									  sizeof(uint8_t));
-							if (kcs_buff == NULL) {
-								k_msleep(10);
-							} else {
-								break;
-							}
-							retry++;
-						} while (retry < MEM_ALLOCATE_RETRY_TIME);
+						kcs_buff = ipmb_pool_alloc(
+							IPMB_POOL_KCS_BUFF,
+							K_MSEC(IPMB_POOL_ALLOC_TIMEOUT_MS));
 						if (kcs_buff == NULL) {
 							LOG_ERR("Failed to allocate memory for I2C resp msg");
 							goto cleanup;
@@ -747,7 +889,7 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 								  HOST_KCS_1,
 							  kcs_buff,
 							  current_msg_rx->buffer.data_len + 3);
-						SAFE_FREE(kcs_buff);
+						IPMB_POOL_FREE(IPMB_POOL_KCS_BUFF, kcs_buff);
 #endif
 					} else if ((current_msg_rx->buffer.InF_source) ==
 						   MPRO_PLDM) {
@@ -755,8 +897,8 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 						pldm_send_ipmb_rsp(&current_msg_rx->buffer);
 #endif
 					} else if (current_msg_rx->buffer.InF_source == ME_IPMB) {
-						ipmi_msg *bridge_msg =
-							(ipmi_msg *)malloc(sizeof(ipmi_msg));
+						ipmi_msg *bridge_msg = (ipmi_msg *)ipmb_pool_alloc(
+							IPMB_POOL_BRIDGE_MSG, K_NO_WAIT);
 						if (bridge_msg == NULL) {
 							LOG_ERR("bridge_msg allocation failed");
 							goto cleanup;
@@ -797,11 +939,11 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 							LOG_ERR("Failed to send IPMB response message");
 						}
 
-						SAFE_FREE(bridge_msg);
+						IPMB_POOL_FREE(IPMB_POOL_BRIDGE_MSG, bridge_msg);
 					} else { // Bridge response to other fru
 
-						ipmi_msg *bridge_msg =
-							(ipmi_msg *)malloc(sizeof(ipmi_msg));
+						ipmi_msg *bridge_msg = (ipmi_msg *)ipmb_pool_alloc(
+							IPMB_POOL_BRIDGE_MSG, K_NO_WAIT);
 						if (bridge_msg == NULL) {
 							LOG_ERR("bridge_msg allocation failed");
 							goto cleanup;
@@ -847,7 +989,7 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 							}
 						}
 
-						SAFE_FREE(bridge_msg);
+						IPMB_POOL_FREE(IPMB_POOL_BRIDGE_MSG, bridge_msg);
 					}
 				}
 
@@ -860,7 +1002,8 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
                  * instead of calling IPMI handler.
                  */
 								     current_msg_rx->buffer.cmd))) {
-					ipmi_msg *bridge_msg = (ipmi_msg *)malloc(sizeof(ipmi_msg));
+					ipmi_msg *bridge_msg = (ipmi_msg *)ipmb_pool_alloc(
+						IPMB_POOL_BRIDGE_MSG, K_NO_WAIT);
 					if (bridge_msg == NULL) {
 						LOG_ERR("bridge_msg allocation failed");
 						goto cleanup;
@@ -913,7 +1056,7 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 						}
 					}
 
-					SAFE_FREE(bridge_msg);
+					IPMB_POOL_FREE(IPMB_POOL_BRIDGE_MSG, bridge_msg);
 				} else {
 					/* The received message is a request
            * Record sequence number for later response
@@ -935,13 +1078,18 @@ void IPMB_RXTask(void *pvParameters, void *arvg0, void *arvg1)
 			}
 		}
 	cleanup:
-		SAFE_FREE(current_msg_rx);
-		SAFE_FREE(ipmb_buffer_rx);
-		k_msleep(IPMB_POLLING_TIME_MS);
+		IPMB_POOL_FREE(IPMB_POOL_MSG_CFG, current_msg_rx);
+		IPMB_POOL_FREE(IPMB_POOL_RX_BUFF, ipmb_buffer_rx);
+		/* The ipmb_slave driver gives no arrival notification, so IPMB RX still polls.
+		 * Drain back-to-back frames and only poll-wait once the driver is empty. */
+		if (rx_len == 0) {
+			k_msleep(IPMB_POLLING_TIME_MS);
+		}
 	}
 }
 
-ipmb_error ipmb_send_request(ipmi_msg *req, uint8_t index)
+/* Queue a request; when resp is given, the response is copied there and completes seq_waiter */
+static ipmb_error queue_request(ipmi_msg *req, uint8_t index, ipmi_msg *resp, uint8_t *seq)
 {
 	CHECK_NULL_ARG_WITH_RETURN(req, IPMB_ERROR_UNKNOWN);
 	CHECK_MSGQ_INIT_WITH_RETURN(&ipmb_txqueue[index], IPMB_ERROR_UNKNOWN);
@@ -970,6 +1118,9 @@ ipmb_error ipmb_send_request(ipmi_msg *req, uint8_t index)
 	req_cfg.buffer.src_addr = IPMB_config_table[index].self_address << 1;
 	req_cfg.buffer.seq = get_free_seq(index);
 	req->seq = req_cfg.buffer.seq;
+	if (seq != NULL) {
+		*seq = req_cfg.buffer.seq;
+	}
 
 	req_cfg.buffer.seq_source = req->seq_source;
 	req_cfg.buffer.src_LUN = 0;
@@ -980,7 +1131,14 @@ ipmb_error ipmb_send_request(ipmi_msg *req, uint8_t index)
 		req_cfg.buffer.completion_code, req_cfg.buffer.data_len);
 	LOG_HEXDUMP_DBG(req_cfg.buffer.data, req_cfg.buffer.data_len, "");
 
+	if (resp != NULL) {
+		arm_seq_waiter(index, req_cfg.buffer.seq, resp);
+	}
+
 	if (k_msgq_put(&ipmb_txqueue[index], &req_cfg, K_MSEC(1000)) != osOK) {
+		if (resp != NULL) {
+			disarm_seq_waiter(index, req_cfg.buffer.seq);
+		}
 		k_mutex_unlock(&mutex_send_req[index]);
 		return IPMB_ERROR_FAILURE;
 	}
@@ -988,6 +1146,11 @@ ipmb_error ipmb_send_request(ipmi_msg *req, uint8_t index)
 	return IPMB_ERROR_SUCCESS;
 }
 
+ipmb_error ipmb_send_request(ipmi_msg *req, uint8_t index)
+{
+	return queue_request(req, index, NULL, NULL);
+}
+
 ipmb_error ipmb_send_response(ipmi_msg *resp, uint8_t index)
 {
 	CHECK_NULL_ARG_WITH_RETURN(resp, IPMB_ERROR_UNKNOWN);
@@ -1038,39 +1201,31 @@ ipmb_error ipmb_send_response(ipmi_msg *resp, uint8_t index)
 ipmb_error ipmb_read(ipmi_msg *msg, uint8_t index)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg, IPMB_ERROR_UNKNOWN);
-	CHECK_MSGQ_INIT_WITH_RETURN(&ipmb_rxqueue[index], IPMB_ERROR_UNKNOWN);
-	CHECK_MUTEX_INIT_WITH_RETURN(&mutex_read, IPMB_ERROR_UNKNOWN);
-
-	// Set mutex timeout 10ms more than messageQueue timeout, prevent mutex
-	// timeout before messageQueue
-	if (k_mutex_lock(&mutex_read, K_MSEC(IPMB_SEQ_TIMEOUT_MS + 10))) {
-		LOG_ERR("Failed to lock mutex in time, netfn0x%02x cmd0x%02x", msg->netfn,
-			msg->cmd);
-		return IPMB_ERROR_MUTEX_LOCK;
-	}
+	CHECK_MUTEX_INIT_WITH_RETURN(&mutex_waiter[index], IPMB_ERROR_UNKNOWN);
 
-	// Reset a Message Queue to initialize empty state
-	k_msgq_purge(&ipmb_rxqueue[index]);
+	/* Keep the request header, msg is overwritten once the response lands */
+	uint8_t netfn = msg->netfn, cmd = msg->cmd, seq = 0;
+
+	if (queue_request(msg, index, msg, &seq) != IPMB_ERROR_SUCCESS) {
+		LOG_ERR("Failed to send IPMB request message, netfn0x%02x cmd0x%02x", netfn, cmd);
+		return IPMB_ERROR_FAILURE;
+	}
 
-	ipmb_error ret = IPMB_ERROR_SUCCESS;
-	if (ipmb_send_request(msg, index) != IPMB_ERROR_SUCCESS) {
-		LOG_ERR("Failed to send IPMB request message, netfn0x%02x cmd0x%02x", msg->netfn,
-			msg->cmd);
-		ret = IPMB_ERROR_FAILURE;
-		goto exit;
+	ipmb_seq_waiter *waiter = &seq_waiter[index][seq];
+	if (k_sem_take(&waiter->done, K_MSEC(IPMB_SEQ_TIMEOUT_MS)) == 0) {
+		return waiter->ret;
 	}
 
-	if (k_msgq_get(&ipmb_rxqueue[index], (ipmi_msg *)msg, K_MSEC(IPMB_SEQ_TIMEOUT_MS))) {
-		LOG_ERR("Failed to get IPMB message from RX queue, netfn0x%02x cmd0x%02x seq%d",
-			msg->netfn, msg->cmd, msg->seq);
-		clear_req_ipmi_msg(P_start[index], (ipmi_msg *)msg, index);
-		ret = IPMB_ERROR_GET_MESSAGE_QUEUE;
-		goto exit;
+	if (!disarm_seq_waiter(index, seq)) {
+		/* Completed between the timeout and the disarm */
+		k_sem_take(&waiter->done, K_NO_WAIT);
+		return waiter->ret;
 	}
 
-exit:
-	k_mutex_unlock(&mutex_read);
-	return ret;
+	LOG_ERR("Failed to get IPMB response in time, netfn0x%02x cmd0x%02x seq%d", netfn, cmd,
+		seq);
+	clear_req_ipmi_msg((ipmi_msg *)msg, index);
+	return IPMB_ERROR_GET_MESSAGE_QUEUE;
 }
 
 ipmb_error ipmb_encode(uint8_t *buffer, ipmi_msg *msg)
@@ -1127,52 +1282,6 @@ ipmb_error ipmb_decode(ipmi_msg *msg, uint8_t *buffer, uint8_t len)
 	return IPMB_ERROR_SUCCESS;
 }
 
-void IPMB_SeqTimeout_handler(void *arug0, void *arug1, void *arug2)
-{
-	ipmi_msg_cfg *pnode;
-	int ret;
-	uint8_t index;
-	uint32_t current_time;
-
-	while (1) {
-		k_msleep(IPMB_SEQ_TIMEOUT_MS);
-		for (index = 0; index < MAX_IPMB_IDX; index++) {
-			if (!IPMB_config_table[index].enable_status) {
-				continue;
-			}
-
-			ret = k_mutex_lock(&mutex_id[index], K_MSEC(1000));
-
-			if (ret) {
-				LOG_ERR("Failed to lock the mutex, ret(%d)", ret);
-			} else {
-				pnode = P_start[index];
-				while (pnode->next != P_start[index]) {
-					current_time = osKernelGetSysTimerCount();
-					// The queue stay more than 1000 ms need to be killed
-					if (current_time + tick_fix -
-							    ((pnode->next)->buffer.timestamp) >
-						    (IPMB_SEQ_TIMEOUT_MS / 1000) * sys_tick_freq ||
-					    (current_time + tick_fix -
-					     ((pnode->next)->buffer.timestamp)) &
-						    0x80000000) {
-						ipmi_msg_cfg *temp;
-						temp = pnode->next;
-						pnode->next = temp->next;
-						unregister_seq(index, temp->buffer.seq_target);
-						SAFE_FREE(temp);
-						seq_current_count[index]--;
-					}
-
-					pnode = pnode->next;
-				}
-
-				k_mutex_unlock(&mutex_id[index]);
-			}
-		}
-	}
-}
-
 static void register_target_device(void)
 {
 #ifdef DEV_IPMB_0
@@ -1234,18 +1343,15 @@ void create_ipmb_threads(uint8_t index)
 
 	memset(&IPMB_TxTask_attr, 0, sizeof(IPMB_TxTask_attr));
 	memset(&IPMB_RxTask_attr, 0, sizeof(IPMB_RxTask_attr));
-	memset(&seq_table[index], 0, sizeof(bool) * SEQ_NUM);
 
-	P_start[index] = (void *)malloc(sizeof(struct ipmi_msg_cfg));
-	if (P_start[index] == NULL) {
-		LOG_ERR("Memory allocation failed!");
-		return;
+	int i = 0, retry = 3;
+	for (i = 0; i < SEQ_NUM; i++) {
+		seq_table[index][i].index = index;
+		seq_table[index][i].seq = i;
+		seq_table[index][i].used = false;
+		k_work_init_delayable(&seq_table[index][i].expire_work, seq_expire_handler);
 	}
 
-	P_temp = P_start[index];
-	P_temp->next = P_temp;
-
-	int i = 0, retry = 3;
 	for (i = 0; i <= retry; ++i) {
 		if (k_mutex_init(&mutex_id[index]) == 0) {
 			break;
@@ -1260,8 +1366,11 @@ void create_ipmb_threads(uint8_t index)
 
 	k_msgq_init(&ipmb_txqueue[index], ipmb_txqueue_buffer[index], sizeof(struct ipmi_msg_cfg),
 		    IPMB_TXQUEUE_LEN);
-	k_msgq_init(&ipmb_rxqueue[index], ipmb_rxqueue_buffer[index], sizeof(struct ipmi_msg),
-		    IPMB_RXQUEUE_LEN);
+	k_mutex_init(&mutex_waiter[index]);
+	for (i = 0; i < SEQ_NUM; i++) {
+		k_sem_init(&seq_waiter[index][i].done, 0, 1);
+		seq_waiter[index][i].armed = false;
+	}
 
 	IPMB_TX_ID[index] =
 		k_thread_create(&IPMB_TX[index], ipmb_tx_stacks[index], IPMB_TX_STACK_SIZE,
@@ -1332,10 +1441,6 @@ void ipmb_init(void)
 
 	memset(&current_seq, 0, sizeof(uint8_t) * MAX_IPMB_IDX);
 
-	// Get the RTOS kernel system timer
-	sys_tick_freq = osKernelGetSysTimerFreq();
-	tick_fix = sys_tick_freq / 1000;
-
 	// Initial mutex
 	for (i = 0; i < MAX_IPMB_IDX; i++) {
 		if (k_mutex_init(&mutex_send_req[i])) {
@@ -1345,20 +1450,21 @@ void ipmb_init(void)
 	if (k_mutex_init(&mutex_send_res)) {
 		LOG_ERR("Failed to initialize IPMB send response mutex");
 	}
-	if (k_mutex_init(&mutex_read)) {
-		LOG_ERR("Failed to initialize IPMB read mutex");
-	}
 	// Create IPMB threads for each index
 	for (index = 0; index < MAX_IPMB_IDX; index++) {
 		if (IPMB_config_table[index].enable_status) {
 			create_ipmb_threads(index);
 		}
 	}
+}
+#else
+bool ipmb_get_pool_stat(uint8_t pool_id, ipmb_pool_stat *stat)
+{
+	return false;
+}
 
-	// Create IPMB sequence number timeout thread
-	k_thread_create(&IPMB_SeqTimeout, IPMB_SeqTimeout_stack,
-			K_THREAD_STACK_SIZEOF(IPMB_SeqTimeout_stack), IPMB_SeqTimeout_handler, NULL,
-			NULL, NULL, CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
-	k_thread_name_set(&IPMB_SeqTimeout, "IPMB_SeqTimeout");
+bool ipmb_get_rx_stat(uint8_t index, ipmb_rx_stat *stat)
+{
+	return false;
 }
 #endif
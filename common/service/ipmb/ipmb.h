@@ -63,7 +63,6 @@
 #define DEBUG_IPMB 0
 
 #define SEQ_NUM 64
-#define MAX_SEQ_QUENE 15
 #define MEM_ALLOCATE_RETRY_TIME 2
 #define IPMI_DATA_MAX_LENGTH 520
 #define IPMB_REQ_HEADER_LENGTH 6
@@ -71,7 +70,6 @@
 #define IPMI_MSG_MAX_LENGTH (IPMI_DATA_MAX_LENGTH + IPMB_RESP_HEADER_LENGTH)
 #define IPMB_TX_RETRY_TIME 5
 #define IPMB_TXQUEUE_LEN 1
-#define IPMB_RXQUEUE_LEN 2
 #define IPMB_TX_STACK_SIZE 3072
 #define IPMB_RX_STACK_SIZE 3072
 #define IPMI_HEADER_CHECKSUM_POSITION 2
@@ -82,7 +80,6 @@
 #define IPMB_RETRY_DELAY_MS 500
 #define IPMB_POLLING_TIME_MS 1
 #define IPMB_SEQ_TIMEOUT_MS 3000
-#define IPMB_SEQ_TIMEOUT_STACK_SIZE 512
 #define I2C_RETRY_TIME 5
 
 #define RESERVED_IDX 0xFF
@@ -192,6 +189,20 @@ typedef struct ipmi_msg_cfg {
 	struct ipmi_msg_cfg *next;
 } __attribute__((packed, aligned(4))) ipmi_msg_cfg;
 
+typedef struct ipmb_pool_stat {
+	const char *name;
+	uint16_t block_size;
+	uint16_t block_num; /**< 0 when the pool falls back to the heap */
+	uint16_t used;
+	uint16_t max_used; /**< High-water mark since boot */
+	uint32_t alloc_fail;
+} ipmb_pool_stat;
+
+typedef struct ipmb_rx_stat {
+	uint32_t wakeup_cnt; /**< RX task loop iterations, i.e. driver polls */
+	uint32_t frame_cnt; /**< Frames actually read from the driver */
+} ipmb_rx_stat;
+
 bool pal_load_ipmb_config(void);
 bool pal_is_interface_use_ipmb(uint8_t interface_index);
 void ipmb_init(void);
@@ -200,6 +211,8 @@ ipmb_error ipmb_send_response(ipmi_msg *resp, uint8_t index);
 ipmb_error ipmb_read(ipmi_msg *msg, uint8_t bus);
 void ipmb_tx_suspend(uint8_t index);
 void ipmb_tx_resume(uint8_t index);
+bool ipmb_get_pool_stat(uint8_t pool_id, ipmb_pool_stat *stat);
+bool ipmb_get_rx_stat(uint8_t index, ipmb_rx_stat *stat);
 
 void pal_encode_response_bridge_cmd(ipmi_msg *bridge_msg, ipmi_msg_cfg *current_msg_rx,
 				    IPMB_config *ipmb_cfg, IPMB_config *IPMB_config_tables);
@@ -37,6 +37,31 @@ extern uint8_t isPwOn;
 extern struct k_msgq ipmi_msgq;
 extern struct k_msgq self_ipmi_msgq;
 
+enum IPMI_LANE {
+	IPMI_LANE_FAST, /* cached reads, never blocked behind long-running commands */
+	IPMI_LANE_SLOW,
+	IPMI_LANE_MAX,
+};
+
+typedef struct ipmi_lane_stat {
+	const char *name;
+	uint32_t handled;
+	uint32_t timeout;
+	uint32_t busy; /* answered node busy because the lane was full */
+	uint16_t queue_depth;
+	uint16_t queue_max; /* high-water mark since boot */
+	uint32_t latency_last_ms; /* from dispatch to handler done */
+	uint32_t latency_max_ms;
+} ipmi_lane_stat;
+
+typedef struct ipmi_msgq_stat {
+	uint32_t reject_full; /* answered node busy because ipmi_msgq was full */
+	uint32_t reject_source; /* answered node busy because the source was over its limit */
+	uint32_t drop; /* aborted on handler timeout without a response */
+	uint16_t queue_depth;
+	uint16_t queue_max; /* high-water mark since boot */
+} ipmi_msgq_stat;
+
 struct ipmi_request {
 	uint8_t netfn;
 	uint8_t cmd;
@@ -83,6 +108,11 @@ bool pal_request_msg_to_BIC_from_ME(uint8_t netfn, uint8_t cmd);
 // For the command that BIC only bridges it, BIC doesn't return the command directly
 // For this kind of commands we return through IPMB that receiving the responses from the other devices.
 bool pal_is_not_return_cmd(uint8_t netfn, uint8_t cmd);
+// Commands served by the fast IPMI lane, they should only return cached data
+bool pal_is_ipmi_fast_cmd(ipmi_msg *msg);
+uint32_t pal_get_ipmi_cmd_timeout_ms(uint8_t netfn, uint8_t cmd);
+bool ipmi_get_lane_stat(uint8_t lane_id, ipmi_lane_stat *stat);
+bool ipmi_get_msgq_stat(ipmi_msgq_stat *stat);
 bool common_add_sel_evt_record(common_addsel_msg_t *sel_msg);
 void ipmi_init(void);
 void IPMI_handler(void *arug0, void *arug1, void *arug2);
@@ -103,6 +133,7 @@ enum {
 	CC_SENSOR_NOT_PRESENT = 0xCB,
 	CC_INVALID_DATA_FIELD = 0xCC,
 	CC_CAN_NOT_RESPOND = 0xCE,
+	CC_INSUFFICIENT_PRIVILEGE = 0xD4,
 	CC_NOT_SUPP_IN_CURR_STATE = 0xD5,
 	CC_UNSPECIFIED_ERROR = 0xFF,
 
@@ -302,6 +333,9 @@ enum {
 	CMD_OEM_1S_GET_PCIE_RETIMER_TYPE = 0x79,
 
 	CMD_OEM_1S_MULTI_ACCURACY_SENSOR_READING = 0x88,
+	CMD_OEM_1S_BULK_SENSOR_READING = 0x89,
+	CMD_OEM_1S_GET_IPMI_QUEUE_STAT = 0x8A,
+	CMD_OEM_1S_GET_SENSOR_ENERGY = 0x8B,
 	CMD_OEM_1S_GET_BOARD_ID = 0xA0,
 	CMD_OEM_1S_GET_CARD_TYPE = 0xA1,
 	CMD_OEM_1S_GET_BIOS_VERSION = 0xA2,
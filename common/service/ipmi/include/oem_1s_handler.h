@@ -78,6 +78,12 @@ typedef struct _ACCURACY_SENSOR_READING_RES {
 	uint8_t status;
 } ACCURACY_SENSOR_READING_RES;
 
+typedef struct _BULK_SENSOR_READING_ENTRY {
+	uint8_t sensor_num;
+	uint8_t status;
+	int32_t reading;
+} __attribute__((packed)) BULK_SENSOR_READING_ENTRY;
+
 uint8_t gpio_idx_exchange(ipmi_msg *msg);
 
 void OEM_1S_MSG_OUT(ipmi_msg *msg);
@@ -93,6 +99,9 @@ void OEM_1S_RESET_BMC(ipmi_msg *msg);
 void OEM_1S_READ_FW_IMAGE(ipmi_msg *msg);
 void OEM_1S_SENSOR_POLL_EN(ipmi_msg *msg);
 void OEM_1S_ACCURACY_SENSOR_READING(ipmi_msg *msg);
+void OEM_1S_BULK_SENSOR_READING(ipmi_msg *msg);
+void OEM_1S_GET_IPMI_QUEUE_STAT(ipmi_msg *msg);
+void OEM_1S_GET_SENSOR_ENERGY(ipmi_msg *msg);
 void OEM_1S_GET_SET_GPIO(ipmi_msg *msg);
 void OEM_1S_GET_SET_BIC_VGPIO(ipmi_msg *msg);
 void OEM_1S_GET_FW_SHA256(ipmi_msg *msg);
@@ -166,6 +175,50 @@ void OEM_1S_GET_FAN_RPM(ipmi_msg *msg);
 void OEM_1S_WRITE_READ_DIMM(ipmi_msg *msg);
 #endif
 
+/* Command privilege, same levels as the IPMI session privilege */
+enum IPMI_PRIV {
+	IPMI_PRIV_USER = 0x02,
+	IPMI_PRIV_OPERATOR = 0x03,
+	IPMI_PRIV_ADMIN = 0x04,
+};
+
+#define OEM_1S_CMD_MAY_BLOCK BIT(0) /* touches a bus or flash, never served by the fast lane */
+#define OEM_1S_CMD_MAX_LEN IPMI_DATA_MAX_LENGTH
+
+/*
+ * One OEM 1S command, lengths exclude the IANA and are checked before the handler runs.
+ * Entries are collected from every object file into the oem_1s_cmd_entry section and indexed
+ * by cmd at init, a platform entry replaces the common entry for the same cmd.
+ */
+struct oem_1s_cmd_entry {
+	uint8_t cmd;
+	uint8_t flags;
+	uint8_t priv;
+	uint16_t min_len;
+	uint16_t max_len;
+	void (*handler)(ipmi_msg *msg);
+};
+
+#define _OEM_1S_CMD_DEFINE(_layer, _cmd, _handler, _min_len, _max_len, _flags, _priv)              \
+	static const Z_STRUCT_SECTION_ITERABLE(oem_1s_cmd_entry,                                   \
+					       oem_1s_cmd_##_layer##_##_cmd) = {                   \
+		.cmd = _cmd,                                                                       \
+		.flags = _flags,                                                                   \
+		.priv = _priv,                                                                     \
+		.min_len = _min_len,                                                               \
+		.max_len = _max_len,                                                               \
+		.handler = _handler,                                                               \
+	}
+
+/* Sections are sorted by name, so layer 1 (platform) entries are indexed after layer 0 */
+#define OEM_1S_CMD_DEFINE(_cmd, _handler, _min_len, _max_len, _flags, _priv)                       \
+	_OEM_1S_CMD_DEFINE(0, _cmd, _handler, _min_len, _max_len, _flags, _priv)
+#define PLAT_OEM_1S_CMD_DEFINE(_cmd, _handler, _min_len, _max_len, _flags, _priv)                  \
+	_OEM_1S_CMD_DEFINE(1, _cmd, _handler, _min_len, _max_len, _flags, _priv)
+
+void oem_1s_cmd_table_init(void);
+const struct oem_1s_cmd_entry *oem_1s_cmd_find(uint8_t cmd);
+uint8_t pal_get_ipmi_source_priv(uint8_t source);
 void IPMI_OEM_1S_handler(ipmi_msg *msg);
 
 #endif
@@ -39,6 +39,7 @@
 #include "oem_handler.h"
 #include "oem_1s_handler.h"
 #include "sensor_handler.h"
+#include "sensor.h"
 #include "storage_handler.h"
 #include "mctp.h"
 #include "pldm.h"
@@ -48,51 +49,165 @@ LOG_MODULE_REGISTER(ipmi);
 
 #define IPMI_QUEUE_SIZE 5
 
+#ifdef PLAT_IPMI_FAST_WORKER_NUM
+#define IPMI_FAST_WORKER_NUM PLAT_IPMI_FAST_WORKER_NUM
+#else
+#define IPMI_FAST_WORKER_NUM 1
+#endif
+/* Slow lane commands may rely on being serialized with each other, keep a single worker */
+#define IPMI_SLOW_WORKER_NUM 1
+#define IPMI_WORKER_NUM (IPMI_FAST_WORKER_NUM + IPMI_SLOW_WORKER_NUM)
+#define IPMI_FAST_LANE_QUEUE_SIZE 4
+#define IPMI_SLOW_LANE_QUEUE_SIZE IPMI_BUF_LEN
+#define IPMI_CMD_TIMEOUT_MS 10000
+#define IPMI_WORKER_NAME_LEN 16
+#define IPMI_SOURCE_NUM 0x70 /* InF_source up to the last SSIF channel */
+#ifdef PLAT_IPMI_SOURCE_INFLIGHT_LIMIT
+#define IPMI_SOURCE_INFLIGHT_LIMIT PLAT_IPMI_SOURCE_INFLIGHT_LIMIT
+#else
+#define IPMI_SOURCE_INFLIGHT_LIMIT (IPMI_BUF_LEN / 2)
+#endif
+
 struct k_thread IPMI_thread;
 K_KERNEL_STACK_MEMBER(IPMI_thread_stack, IPMI_THREAD_STACK_SIZE);
 
-struct k_thread IPMI_handle_thread;
-K_KERNEL_STACK_MEMBER(IPMI_handle_thread_stack, IPMI_HANDLE_THREAD_STACK_SIZE);
+typedef struct ipmi_lane_msg {
+	ipmi_msg_cfg msg_cfg;
+	uint32_t enqueue_ms;
+} __attribute__((aligned(4))) ipmi_lane_msg;
+
+typedef struct ipmi_lane {
+	struct k_msgq msgq;
+	ipmi_lane_stat stat;
+} ipmi_lane;
+
+typedef struct ipmi_worker {
+	struct k_thread thread;
+	k_tid_t tid;
+	uint8_t lane_id;
+	ipmi_lane_msg cur; /* message in progress, kept off the worker stack */
+	bool busy;
+	struct k_work_delayable watchdog;
+	char name[IPMI_WORKER_NAME_LEN];
+} ipmi_worker;
+
+char __aligned(4) ipmi_fast_lane_buffer[IPMI_FAST_LANE_QUEUE_SIZE * sizeof(ipmi_lane_msg)];
+char __aligned(4) ipmi_slow_lane_buffer[IPMI_SLOW_LANE_QUEUE_SIZE * sizeof(ipmi_lane_msg)];
+static ipmi_lane ipmi_lanes[IPMI_LANE_MAX] = {
+	[IPMI_LANE_FAST] = { .stat = { .name = "fast" } },
+	[IPMI_LANE_SLOW] = { .stat = { .name = "slow" } },
+};
+static struct k_spinlock ipmi_lane_lock;
+
+K_THREAD_STACK_ARRAY_DEFINE(ipmi_worker_stacks, IPMI_WORKER_NUM, IPMI_HANDLE_THREAD_STACK_SIZE);
+static ipmi_worker ipmi_workers[IPMI_WORKER_NUM];
 
 char __aligned(4) ipmi_msgq_buffer[IPMI_BUF_LEN * sizeof(struct ipmi_msg_cfg)];
 struct k_msgq ipmi_msgq;
 char __aligned(4) self_ipmi_msgq_buffer[1 * sizeof(struct ipmi_msg_cfg)];
 struct k_msgq self_ipmi_msgq;
 
-static struct k_mutex mutex_purge_msgq;
+/* in-flight requests per InF_source, from admission until the handler is done with them */
+static uint8_t ipmi_source_inflight[IPMI_SOURCE_NUM];
+static ipmi_msgq_stat ipmi_queue_stat;
+static struct k_spinlock ipmi_admit_lock;
+
+static void ipmi_send_response(ipmi_msg_cfg *msg_cfg);
+
+static uint8_t ipmi_source_idx(uint8_t source)
+{
+	return MIN(source, IPMI_SOURCE_NUM - 1);
+}
+
+/* Called once a request admitted by notify_ipmi_client has been answered or dropped */
+static void ipmi_source_release(uint8_t source)
+{
+	k_spinlock_key_t key = k_spin_lock(&ipmi_admit_lock);
+	if (ipmi_source_inflight[ipmi_source_idx(source)]) {
+		ipmi_source_inflight[ipmi_source_idx(source)]--;
+	}
+	k_spin_unlock(&ipmi_admit_lock, key);
+}
+
+/* Answer a request that can't be queued with node busy, the caller's request is left untouched */
+static bool ipmi_reply_busy(const ipmi_msg_cfg *msg_cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(msg_cfg, false);
+
+	if (pal_is_not_return_cmd(msg_cfg->buffer.netfn, msg_cfg->buffer.cmd)) {
+		return false;
+	}
+
+	ipmi_msg_cfg busy_resp = { 0 };
+	busy_resp = *msg_cfg;
+
+	busy_resp.buffer.completion_code = CC_NODE_BUSY;
+	busy_resp.buffer.data_len = 0;
+	ipmi_send_response(&busy_resp);
+	return true;
+}
+
+bool ipmi_get_msgq_stat(ipmi_msgq_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	k_spinlock_key_t key = k_spin_lock(&ipmi_admit_lock);
+	memcpy(stat, &ipmi_queue_stat, sizeof(ipmi_msgq_stat));
+	k_spin_unlock(&ipmi_admit_lock, key);
+	stat->queue_depth = k_msgq_num_used_get(&ipmi_msgq);
+	return true;
+}
 
-// Send message to IPMI message queue
+/*
+ * Send message to IPMI message queue. A full queue, or a source already holding
+ * IPMI_SOURCE_INFLIGHT_LIMIT requests, gets a node busy response instead of being queued.
+ */
 ipmb_error notify_ipmi_client(ipmi_msg_cfg *msg_cfg)
 {
 	CHECK_NULL_ARG_WITH_RETURN(msg_cfg, IPMB_ERROR_UNKNOWN);
-	uint32_t free_size = 0;
-	int ret = 0, ret_lock = 0;
-	int retry = 3;
 
 	/* Sends only the ipmi msg, not the control struct */
-	if (!IS_RESPONSE(msg_cfg->buffer)) {
-		ret = k_msgq_put(&ipmi_msgq, msg_cfg, K_NO_WAIT);
-		while (ret != 0 && retry > 0) {
-			ret_lock = k_mutex_lock(&mutex_purge_msgq, K_MSEC(1000));
-			if (ret_lock < 0) {
-				LOG_ERR("Failed to get ipmi msgq purge mutex");
-				retry--;
-				continue;
-			} else {
-				free_size = k_msgq_num_free_get(&ipmi_msgq);
-				if (free_size == 0) {
-					/* message queue is full: purge old data & try again */
-					LOG_INF("Purge ipmi_msgq due to queue is full");
-					k_msgq_purge(&ipmi_msgq);
-				}
-				k_mutex_unlock(&mutex_purge_msgq);
-			}
-			LOG_INF("Retry to send message to IPMI message queue, ret = %d", ret);
-			ret = k_msgq_put(&ipmi_msgq, msg_cfg, K_NO_WAIT);
-			retry--;
-		}
+	if (IS_RESPONSE(msg_cfg->buffer)) {
+		return IPMB_ERROR_SUCCESS;
+	}
+
+	uint8_t source = msg_cfg->buffer.InF_source;
+	uint8_t idx = ipmi_source_idx(source);
+	bool over_limit = false;
+
+	k_spinlock_key_t key = k_spin_lock(&ipmi_admit_lock);
+	if (ipmi_source_inflight[idx] >= IPMI_SOURCE_INFLIGHT_LIMIT) {
+		ipmi_queue_stat.reject_source++;
+		over_limit = true;
+	} else {
+		ipmi_source_inflight[idx]++;
+	}
+	k_spin_unlock(&ipmi_admit_lock, key);
+
+	if (over_limit) {
+		LOG_WRN("IPMI source 0x%x over in-flight limit, netfn: %x, cmd: %x", source,
+			msg_cfg->buffer.netfn, msg_cfg->buffer.cmd);
+		return ipmi_reply_busy(msg_cfg) ? IPMB_ERROR_SUCCESS : IPMB_ERROR_FAILURE;
 	}
-	return (retry == 0) ? IPMB_ERROR_MUTEX_LOCK : IPMB_ERROR_SUCCESS;
+
+	if (k_msgq_put(&ipmi_msgq, msg_cfg, K_NO_WAIT)) {
+		ipmi_source_release(source);
+		key = k_spin_lock(&ipmi_admit_lock);
+		ipmi_queue_stat.reject_full++;
+		k_spin_unlock(&ipmi_admit_lock, key);
+		LOG_WRN("IPMI message queue full, netfn: %x, cmd: %x", msg_cfg->buffer.netfn,
+			msg_cfg->buffer.cmd);
+		return ipmi_reply_busy(msg_cfg) ? IPMB_ERROR_SUCCESS : IPMB_ERROR_FAILURE;
+	}
+
+	uint16_t depth = k_msgq_num_used_get(&ipmi_msgq);
+	key = k_spin_lock(&ipmi_admit_lock);
+	if (depth > ipmi_queue_stat.queue_max) {
+		ipmi_queue_stat.queue_max = depth;
+	}
+	k_spin_unlock(&ipmi_admit_lock, key);
+
+	return IPMB_ERROR_SUCCESS;
 }
 
 __weak uint32_t get_iana(uint8_t *iana_buf)
@@ -205,6 +320,36 @@ __weak bool pal_request_msg_to_BIC_from_ME(uint8_t netfn, uint8_t cmd)
 	return false;
 }
 
+/* Commands answered from cached data without touching a bus, served by the fast lane */
+__weak bool pal_is_ipmi_fast_cmd(ipmi_msg *msg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(msg, false);
+
+	switch (msg->netfn) {
+	case NETFN_SENSOR_REQ:
+		return (msg->cmd == CMD_SENSOR_GET_SENSOR_READING);
+	case NETFN_APP_REQ:
+		return (msg->cmd == CMD_APP_GET_DEVICE_ID);
+	case NETFN_OEM_1S_REQ: {
+		// Accuracy reading avoids the bus only with a cached read option, after the IANA
+		if (msg->cmd == CMD_OEM_1S_ACCURACY_SENSOR_READING) {
+			return (msg->data_len >= 5) && ((msg->data[4] == GET_FROM_CACHE) ||
+							(msg->data[4] == GET_FROM_ENERGY_ACCUM));
+		}
+
+		const struct oem_1s_cmd_entry *entry = oem_1s_cmd_find(msg->cmd);
+		return (entry != NULL) && !(entry->flags & OEM_1S_CMD_MAY_BLOCK);
+	}
+	default:
+		return false;
+	}
+}
+
+__weak uint32_t pal_get_ipmi_cmd_timeout_ms(uint8_t netfn, uint8_t cmd)
+{
+	return IPMI_CMD_TIMEOUT_MS;
+}
+
 __weak bool pal_is_not_return_cmd(uint8_t netfn, uint8_t cmd)
 {
 	if (netfn == NETFN_OEM_1S_REQ) {
@@ -275,6 +420,83 @@ bool common_add_sel_evt_record(common_addsel_msg_t *sel_msg)
 	return ipmb_flag;
 }
 
+/* Send a handled request's response back to the interface it came from */
+static void ipmi_send_response(ipmi_msg_cfg *msg_cfg)
+{
+	CHECK_NULL_ARG(msg_cfg);
+
+	switch (msg_cfg->buffer.InF_source) {
+#ifdef CONFIG_USB
+	case BMC_USB:
+		usb_write_by_ipmi(&msg_cfg->buffer);
+		break;
+#endif
+#ifdef CONFIG_IPMI_KCS_ASPEED
+	case HOST_KCS_1:
+	case HOST_KCS_2:
+	case HOST_KCS_3:
+	case HOST_KCS_4: {
+		uint8_t *kcs_buff;
+		kcs_buff = malloc(KCS_BUFF_SIZE * sizeof(uint8_t));
+		if (kcs_buff == NULL) { // allocate fail, retry allocate
+			k_msleep(10);
+			kcs_buff = malloc(KCS_BUFF_SIZE * sizeof(uint8_t));
+			if (kcs_buff == NULL) {
+				LOG_ERR("IPMI_handler: Fail to malloc for kcs_buff");
+				return;
+			}
+		}
+		kcs_buff[0] = (msg_cfg->buffer.netfn + 1) << 2; // ipmi netfn response package
+		kcs_buff[1] = msg_cfg->buffer.cmd;
+		kcs_buff[2] = msg_cfg->buffer.completion_code;
+		if (msg_cfg->buffer.data_len) {
+			if (msg_cfg->buffer.data_len <= (KCS_BUFF_SIZE - 3))
+				memcpy(&kcs_buff[3], msg_cfg->buffer.data, msg_cfg->buffer.data_len);
+			else
+				memcpy(&kcs_buff[3], msg_cfg->buffer.data, (KCS_BUFF_SIZE - 3));
+		}
+
+		LOG_DBG("kcs from ipmi netfn %x, cmd %x, length %d, cc %x", kcs_buff[0],
+			kcs_buff[1], msg_cfg->buffer.data_len, kcs_buff[2]);
+
+		kcs_write(msg_cfg->buffer.InF_source - HOST_KCS_1, kcs_buff,
+			  msg_cfg->buffer.data_len + 3);
+		SAFE_FREE(kcs_buff);
+		break;
+	}
+#endif
+#ifdef ENABLE_SSIF
+	case HOST_SSIF_1:
+		msg_cfg->buffer.netfn = (msg_cfg->buffer.netfn + 1) << 2;
+		if (ssif_set_data(msg_cfg->buffer.InF_source - HOST_SSIF_1, msg_cfg) == false)
+			LOG_ERR("Failed to write ssif response data");
+		break;
+#endif
+	case PLDM:
+		/* the message should be passed to source by pldm format */
+		send_msg_by_pldm(msg_cfg);
+		break;
+	case SELF:
+		/* for bic self test */
+		if (k_msgq_put(&self_ipmi_msgq, msg_cfg, K_NO_WAIT)) {
+			k_msgq_purge(&self_ipmi_msgq);
+			LOG_ERR("Failed to put msg into self ipmi msgq");
+		}
+		break;
+	default: {
+#if MAX_IPMB_IDX
+		ipmb_error status;
+		status = ipmb_send_response(&msg_cfg->buffer,
+					    IPMB_inf_index_map[msg_cfg->buffer.InF_source]);
+		if (status != IPMB_ERROR_SUCCESS) {
+			LOG_ERR("IPMI_handler send IPMB resp fail status: %x", status);
+		}
+#endif
+		break;
+	}
+	}
+}
+
 void ipmi_cmd_handle(void *parameters, void *arvg0, void *arvg1)
 {
 	CHECK_NULL_ARG(parameters);
@@ -354,111 +576,168 @@ void ipmi_cmd_handle(void *parameters, void *arvg0, void *arvg1)
 		msg_cfg.buffer.data[2] = (iana >> 16) & 0xFF;
 	}
 
-	switch (msg_cfg.buffer.InF_source) {
-#ifdef CONFIG_USB
-	case BMC_USB:
-		usb_write_by_ipmi(&msg_cfg.buffer);
-		break;
-#endif
-#ifdef CONFIG_IPMI_KCS_ASPEED
-	case HOST_KCS_1:
-	case HOST_KCS_2:
-	case HOST_KCS_3:
-	case HOST_KCS_4: {
-		uint8_t *kcs_buff;
-		kcs_buff = malloc(KCS_BUFF_SIZE * sizeof(uint8_t));
-		if (kcs_buff == NULL) { // allocate fail, retry allocate
-			k_msleep(10);
-			kcs_buff = malloc(KCS_BUFF_SIZE * sizeof(uint8_t));
-			if (kcs_buff == NULL) {
-				LOG_ERR("IPMI_handler: Fail to malloc for kcs_buff");
-				return;
-			}
-		}
-		kcs_buff[0] = (msg_cfg.buffer.netfn + 1) << 2; // ipmi netfn response package
-		kcs_buff[1] = msg_cfg.buffer.cmd;
-		kcs_buff[2] = msg_cfg.buffer.completion_code;
-		if (msg_cfg.buffer.data_len) {
-			if (msg_cfg.buffer.data_len <= (KCS_BUFF_SIZE - 3))
-				memcpy(&kcs_buff[3], msg_cfg.buffer.data, msg_cfg.buffer.data_len);
-			else
-				memcpy(&kcs_buff[3], msg_cfg.buffer.data, (KCS_BUFF_SIZE - 3));
-		}
+	ipmi_send_response(&msg_cfg);
+}
 
-		LOG_DBG("kcs from ipmi netfn %x, cmd %x, length %d, cc %x", kcs_buff[0],
-			kcs_buff[1], msg_cfg.buffer.data_len, kcs_buff[2]);
+static void ipmi_worker_task(void *arg0, void *arg1, void *arg2);
 
-		kcs_write(msg_cfg.buffer.InF_source - HOST_KCS_1, kcs_buff,
-			  msg_cfg.buffer.data_len + 3);
-		SAFE_FREE(kcs_buff);
-		break;
+static void ipmi_worker_start(ipmi_worker *worker)
+{
+	CHECK_NULL_ARG(worker);
+
+	uint8_t idx = worker - ipmi_workers;
+	worker->busy = false;
+	worker->tid = k_thread_create(&worker->thread, ipmi_worker_stacks[idx],
+				      K_THREAD_STACK_SIZEOF(ipmi_worker_stacks[idx]),
+				      ipmi_worker_task, worker, NULL, NULL,
+				      CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+	k_thread_name_set(worker->tid, worker->name);
+}
+
+/* Abort a worker stuck on one command past its timeout and start a fresh thread in its place */
+static void ipmi_worker_watchdog(struct k_work *work)
+{
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	ipmi_worker *worker = CONTAINER_OF(dwork, ipmi_worker, watchdog);
+
+	k_spinlock_key_t key = k_spin_lock(&ipmi_lane_lock);
+	if (!worker->busy) {
+		k_spin_unlock(&ipmi_lane_lock, key);
+		return;
 	}
-#endif
-#ifdef ENABLE_SSIF
-	case HOST_SSIF_1:
-		msg_cfg.buffer.netfn = (msg_cfg.buffer.netfn + 1) << 2;
-		if (ssif_set_data(msg_cfg.buffer.InF_source - HOST_SSIF_1, &msg_cfg) == false)
-			LOG_ERR("Failed to write ssif response data");
-		break;
-#endif
-	case PLDM:
-		/* the message should be passed to source by pldm format */
-		send_msg_by_pldm(&msg_cfg);
-		break;
-	case SELF:
-		/* for bic self test */
-		if (k_msgq_put(&self_ipmi_msgq, &msg_cfg, K_NO_WAIT)) {
-			k_msgq_purge(&self_ipmi_msgq);
-			LOG_ERR("Failed to put msg into self ipmi msgq");
+	// Claim the command so a handler finishing right now leaves the source to us
+	worker->busy = false;
+	ipmi_lanes[worker->lane_id].stat.timeout++;
+	k_spin_unlock(&ipmi_lane_lock, key);
+
+	k_thread_abort(worker->tid);
+	ipmi_source_release(worker->cur.msg_cfg.buffer.InF_source);
+	key = k_spin_lock(&ipmi_admit_lock);
+	ipmi_queue_stat.drop++;
+	k_spin_unlock(&ipmi_admit_lock, key);
+	LOG_ERR("%s(): abort the handler due to timeout. netfn: %x, cmd: %x", __func__,
+		worker->cur.msg_cfg.buffer.netfn, worker->cur.msg_cfg.buffer.cmd);
+	ipmi_worker_start(worker);
+}
+
+static void ipmi_worker_task(void *arg0, void *arg1, void *arg2)
+{
+	CHECK_NULL_ARG(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	ipmi_worker *worker = (ipmi_worker *)arg0;
+	ipmi_lane *lane = &ipmi_lanes[worker->lane_id];
+
+	while (1) {
+		k_msgq_get(&lane->msgq, &worker->cur, K_FOREVER);
+
+		uint8_t netfn = worker->cur.msg_cfg.buffer.netfn;
+		uint8_t cmd = worker->cur.msg_cfg.buffer.cmd;
+
+		uint32_t timeout_ms = pal_get_ipmi_cmd_timeout_ms(netfn, cmd);
+
+		k_spinlock_key_t key = k_spin_lock(&ipmi_lane_lock);
+		worker->busy = true;
+		k_spin_unlock(&ipmi_lane_lock, key);
+		k_work_reschedule(&worker->watchdog, K_MSEC(timeout_ms));
+
+		ipmi_cmd_handle(&worker->cur.msg_cfg, NULL, NULL);
+
+		key = k_spin_lock(&ipmi_lane_lock);
+		if (!worker->busy) {
+			// The watchdog took the command, it releases the source and aborts us
+			k_spin_unlock(&ipmi_lane_lock, key);
+			k_sleep(K_FOREVER);
 		}
-		break;
-	default: {
-#if MAX_IPMB_IDX
-		ipmb_error status;
-		status = ipmb_send_response(&msg_cfg.buffer,
-					    IPMB_inf_index_map[msg_cfg.buffer.InF_source]);
-		if (status != IPMB_ERROR_SUCCESS) {
-			LOG_ERR("IPMI_handler send IPMB resp fail status: %x", status);
+		worker->busy = false;
+		k_work_cancel_delayable(&worker->watchdog);
+		uint32_t latency_ms = k_uptime_get_32() - worker->cur.enqueue_ms;
+		lane->stat.handled++;
+		lane->stat.latency_last_ms = latency_ms;
+		if (latency_ms > lane->stat.latency_max_ms) {
+			lane->stat.latency_max_ms = latency_ms;
 		}
-#endif
-		break;
+		k_spin_unlock(&ipmi_lane_lock, key);
+
+		ipmi_source_release(worker->cur.msg_cfg.buffer.InF_source);
 	}
+}
+
+bool ipmi_get_lane_stat(uint8_t lane_id, ipmi_lane_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	if (lane_id >= IPMI_LANE_MAX) {
+		return false;
 	}
+
+	k_spinlock_key_t key = k_spin_lock(&ipmi_lane_lock);
+	memcpy(stat, &ipmi_lanes[lane_id].stat, sizeof(ipmi_lane_stat));
+	k_spin_unlock(&ipmi_lane_lock, key);
+	stat->queue_depth = k_msgq_num_used_get(&ipmi_lanes[lane_id].msgq);
+	return true;
 }
 
+/* Route each request from ipmi_msgq to its lane, the lane workers do the actual handling */
 void IPMI_handler(void *arug0, void *arug1, void *arug2)
 {
-	ipmi_msg_cfg msg_cfg;
-	k_tid_t tid = 0;
+	ipmi_lane_msg lane_msg;
 
 	while (1) {
-		memset(&msg_cfg, 0, sizeof(ipmi_msg_cfg));
-		k_msgq_get(&ipmi_msgq, &msg_cfg, K_FOREVER);
-
-		LOG_DBG("IPMI_handler[%d]: netfn: %x", msg_cfg.buffer.data_len,
-			msg_cfg.buffer.netfn);
-		LOG_HEXDUMP_DBG(msg_cfg.buffer.data, msg_cfg.buffer.data_len, "");
-		tid = k_thread_create(&IPMI_handle_thread, IPMI_handle_thread_stack,
-				      K_THREAD_STACK_SIZEOF(IPMI_handle_thread_stack),
-				      ipmi_cmd_handle, (void *)&msg_cfg, NULL, NULL,
-				      CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
-		if (k_thread_join(tid, K_SECONDS(10)) == -EAGAIN) { // timeout
-			k_thread_abort(tid);
-			LOG_ERR("%s(): abort the handler due to timeout. netfn: %x, cmd: %x",
-				__func__, msg_cfg.buffer.netfn, msg_cfg.buffer.cmd);
+		memset(&lane_msg, 0, sizeof(ipmi_lane_msg));
+		k_msgq_get(&ipmi_msgq, &lane_msg.msg_cfg, K_FOREVER);
+		lane_msg.enqueue_ms = k_uptime_get_32();
+
+		ipmi_msg *msg = &lane_msg.msg_cfg.buffer;
+		LOG_DBG("IPMI_handler[%d]: netfn: %x", msg->data_len, msg->netfn);
+		LOG_HEXDUMP_DBG(msg->data, msg->data_len, "");
+
+		ipmi_lane *lane = pal_is_ipmi_fast_cmd(msg) ?
+					  &ipmi_lanes[IPMI_LANE_FAST] :
+					  &ipmi_lanes[IPMI_LANE_SLOW];
+
+		if (k_msgq_put(&lane->msgq, &lane_msg, K_NO_WAIT)) {
+			LOG_WRN("IPMI %s lane full, netfn: %x, cmd: %x", lane->stat.name, msg->netfn,
+				msg->cmd);
+			k_spinlock_key_t key = k_spin_lock(&ipmi_lane_lock);
+			lane->stat.busy++;
+			k_spin_unlock(&ipmi_lane_lock, key);
+			ipmi_source_release(msg->InF_source);
+			ipmi_reply_busy(&lane_msg.msg_cfg);
+			continue;
 		}
-		k_thread_name_set(&IPMI_handle_thread, "IPMI_handle_thread");
+
+		uint16_t depth = k_msgq_num_used_get(&lane->msgq);
+		k_spinlock_key_t key = k_spin_lock(&ipmi_lane_lock);
+		if (depth > lane->stat.queue_max) {
+			lane->stat.queue_max = depth;
+		}
+		k_spin_unlock(&ipmi_lane_lock, key);
 	}
 }
 
 void ipmi_init(void)
 {
 	LOG_DBG("ipmi_init");
+	oem_1s_cmd_table_init();
+
 	k_msgq_init(&ipmi_msgq, ipmi_msgq_buffer, sizeof(struct ipmi_msg_cfg), IPMI_BUF_LEN);
 	k_msgq_init(&self_ipmi_msgq, self_ipmi_msgq_buffer, sizeof(struct ipmi_msg_cfg), 1);
 
-	if (k_mutex_init(&mutex_purge_msgq)) {
-		LOG_ERR("Failed to initialize IPMI put msgq mutex");
+	k_msgq_init(&ipmi_lanes[IPMI_LANE_FAST].msgq, ipmi_fast_lane_buffer, sizeof(ipmi_lane_msg),
+		    IPMI_FAST_LANE_QUEUE_SIZE);
+	k_msgq_init(&ipmi_lanes[IPMI_LANE_SLOW].msgq, ipmi_slow_lane_buffer, sizeof(ipmi_lane_msg),
+		    IPMI_SLOW_LANE_QUEUE_SIZE);
+
+	for (uint8_t i = 0; i < IPMI_WORKER_NUM; i++) {
+		ipmi_worker *worker = &ipmi_workers[i];
+		worker->lane_id = (i < IPMI_FAST_WORKER_NUM) ? IPMI_LANE_FAST : IPMI_LANE_SLOW;
+		snprintf(worker->name, sizeof(worker->name), "IPMI_%s_%d",
+			 ipmi_lanes[worker->lane_id].stat.name,
+			 (i < IPMI_FAST_WORKER_NUM) ? i : i - IPMI_FAST_WORKER_NUM);
+		k_work_init_delayable(&worker->watchdog, ipmi_worker_watchdog);
+		ipmi_worker_start(worker);
 	}
 
 	k_thread_create(&IPMI_thread, IPMI_thread_stack, K_THREAD_STACK_SIZEOF(IPMI_thread_stack),
@@ -21,6 +21,7 @@
 #include "libutil.h"
 #include "ipmb.h"
 #include "sensor.h"
+#include "sensor_energy.h"
 #include "snoop.h"
 #include "pmic.h"
 #include "hal_gpio.h"
@@ -56,6 +57,7 @@
 #include "pcc.h"
 #include "hal_wdt.h"
 #include "pldm.h"
+#include "kcs.h"
 #include <zephyr.h>
 
 #define BIOS_UPDATE_MAX_OFFSET 0x4000000
@@ -65,6 +67,20 @@
 
 #define _4BYTE_ACCURACY_SENSOR_READING_RES_LEN 5
 #define MAX_MULTI_ACCURACY_SENSOR_READING_QUERY_NUM 32
+#define BULK_SENSOR_READING_BITMAP_LEN ((SENSOR_NUM_MAX + 1) / 8)
+#define BULK_SENSOR_READING_HDR_LEN 2
+/* IPMI over PLDM copies the reply behind its own header and must not reach the PLDM context
+ * stashed at the tail of the IPMI buffer */
+#define BULK_SENSOR_READING_PLDM_MAX_LEN                                                           \
+	MIN(PLDM_MAX_DATA_SIZE - (sizeof(struct _ipmi_cmd_resp) - 1),                              \
+	    IPMI_DATA_MAX_LENGTH - sizeof(pldm_hdr) - sizeof(mctp_ext_params) - sizeof(mctp *))
+#ifdef KCS_BUFF_SIZE
+/* KCS sends netfn, cmd and completion code ahead of the reply from a KCS_BUFF_SIZE buffer */
+#define BULK_SENSOR_READING_RESP_MAX_LEN                                                           \
+	(MIN(KCS_BUFF_SIZE - 3, BULK_SENSOR_READING_PLDM_MAX_LEN) - IANA_LEN)
+#else
+#define BULK_SENSOR_READING_RESP_MAX_LEN (BULK_SENSOR_READING_PLDM_MAX_LEN - IANA_LEN)
+#endif
 #define MAX_CONTROL_SENSOR_POLLING_COUNT 10
 #define FOUR_BYTE_POST_CODE_PAGE_SIZE 60
 
@@ -369,11 +385,6 @@ __weak void OEM_1S_GET_BIC_FW_INFO(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	msg->data_len = 0;
 
 	uint8_t component;
@@ -625,11 +636,6 @@ __weak void OEM_1S_RESET_BMC(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 0) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	int ret = pal_submit_bmc_cold_reset();
 	if (ret == -1) {
 		msg->completion_code = CC_INVALID_CMD;
@@ -645,11 +651,6 @@ __weak void OEM_1S_READ_FW_IMAGE(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 6) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t target = msg->data[0];
 	uint32_t offset =
 		((msg->data[4] << 24) | (msg->data[3] << 16) | (msg->data[2] << 8) | msg->data[1]);
@@ -701,11 +702,6 @@ __weak void OEM_1S_SET_WDT_FEED(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	if ((msg->data[0] != 0) && (msg->data[0] != 1)) {
 		msg->completion_code = CC_INVALID_DATA_FIELD;
 		return;
@@ -723,11 +719,6 @@ __weak void OEM_1S_GET_POST_CODE(ipmi_msg *msg)
 	CHECK_NULL_ARG(msg);
 
 	int postcode_num = snoop_read_num;
-	if (msg->data_len != 0) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	if (postcode_num) {
 		uint8_t offset = 0;
 		if (snoop_read_num > POST_CODE_BUF_SIZE) {
@@ -827,11 +818,6 @@ __weak void OEM_1S_PECI_ACCESS(ipmi_msg *msg)
 	uint8_t writeLen, readLen;
 	int ret;
 
-	if (msg->data_len < 3) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	addr = msg->data[0];
 	writeLen = msg->data[1];
 	readLen = msg->data[2];
@@ -894,11 +880,6 @@ __weak void OEM_1S_SET_JTAG_TAP_STA(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 2) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t tapbitlen, tapdata;
 
 	tapbitlen = msg->data[0];
@@ -990,10 +971,6 @@ __weak void OEM_1S_JTAG_TCK_CYCLE(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
 	uint8_t cycle;
 	cycle = msg->data[0];
 	jtag_tck_cycle(cycle);
@@ -1008,11 +985,6 @@ __weak void OEM_1S_ASD_INIT(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	if (msg->data[0] == 0x01) {
 		enable_PRDY_interrupt();
 	} else if (msg->data[0] == 0xff) {
@@ -1034,11 +1006,6 @@ __weak void OEM_1S_SENSOR_POLL_EN(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	if (msg->data[0] == 1) {
 		enable_sensor_poll();
 	} else if (msg->data[0] == 0) {
@@ -1061,11 +1028,6 @@ __weak void OEM_1S_ACCURACY_SENSOR_READING(ipmi_msg *msg)
 	ACCURACY_SENSOR_READING_RES *res = (ACCURACY_SENSOR_READING_RES *)msg->data;
 	uint8_t status = -1, sensor_report_status;
 	int reading;
-	if (msg->data_len != 2) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	// following IPMI sensor status response
 	if (enable_sensor_poll_thread) {
 		sensor_report_status = SENSOR_EVENT_MESSAGES_ENABLE | SENSOR_SCANNING_ENABLE;
@@ -1083,8 +1045,11 @@ __weak void OEM_1S_ACCURACY_SENSOR_READING(ipmi_msg *msg)
 	} else if (req->read_option == GET_FROM_SENSOR) {
 		status = get_sensor_reading(sensor_config, sensor_config_count, req->sensor_num,
 					    &reading, GET_FROM_SENSOR);
+	} else if (req->read_option == GET_FROM_ENERGY_ACCUM) {
+		status = get_sensor_reading(sensor_config, sensor_config_count, req->sensor_num,
+					    &reading, GET_FROM_ENERGY_ACCUM);
 	} else {
-		LOG_ERR("Error: read_option was not either GET_FROM_CACHE or GET_FROM_SENSOR.");
+		LOG_ERR("Error: read_option 0x%x is not supported.", req->read_option);
 		status = SENSOR_UNSPECIFIED_ERROR;
 	}
 	switch (status) {
@@ -1371,10 +1336,6 @@ __weak void OEM_1S_GET_FW_SHA256(ipmi_msg *msg)
 	uint32_t length =
 		(msg->data[5] | (msg->data[6] << 8) | (msg->data[7] << 16) | (msg->data[8] << 24));
 
-	if (msg->data_len != 9) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
 	if (target == BIOS_UPDATE) {
 		int pos = pal_get_bios_flash_position();
 		if (pos == -1) {
@@ -1438,11 +1399,6 @@ __weak void OEM_1S_GET_BIC_STATUS(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 0) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	msg->data[0] = FIRMWARE_REVISION_1;
 	msg->data[1] = FIRMWARE_REVISION_2;
 
@@ -1455,11 +1411,6 @@ __weak void OEM_1S_SET_VR_MONITOR_STATUS(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	if (msg->data[0] == 0) {
 		set_vr_monitor_status(false);
 	} else if (msg->data[0] == 1) {
@@ -1478,11 +1429,6 @@ __weak void OEM_1S_GET_VR_MONITOR_STATUS(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 0) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	msg->data[0] = (uint8_t)get_vr_monitor_status();
 	msg->data_len = 1;
 	msg->completion_code = CC_SUCCESS;
@@ -1493,11 +1439,6 @@ __weak void OEM_1S_RESET_BIC(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 0) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	submit_bic_warm_reset();
 
 	msg->data_len = 0;
@@ -1536,11 +1477,6 @@ __weak void OEM_1S_12V_CYCLE_SLOT(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 0) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	int ret = pal_submit_12v_cycle_slot(msg);
 	switch (ret) {
 	case SUCCESS_12V_CYCLE_SLOT:
@@ -1569,10 +1505,6 @@ __weak void OEM_1S_READ_BIC_REGISTER(ipmi_msg *msg)
 	***********************************/
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 5) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
 	uint32_t *addr = (uint32_t *)(msg->data[0] | (msg->data[1] << 8) | (msg->data[2] << 16) |
 				      (msg->data[3] << 24));
 	uint8_t read_len = msg->data[4];
@@ -1632,11 +1564,6 @@ __weak void OEM_1S_SET_FAN_DUTY_AUTO(ipmi_msg *msg)
 	***********************************/
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 2) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t pwm_id = msg->data[0];
 	uint8_t duty = msg->data[1];
 	uint8_t current_fan_mode = FAN_AUTO_MODE, slot_index = 0;
@@ -1693,11 +1620,6 @@ __weak void OEM_1S_GET_FAN_DUTY(ipmi_msg *msg)
 	***********************************/
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t pwm_id = msg->data[0];
 	uint8_t duty = 0, slot_index = 0;
 	int ret = 0;
@@ -1740,11 +1662,6 @@ __weak void OEM_1S_GET_FAN_RPM(ipmi_msg *msg)
 	***********************************/
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t fan_id = msg->data[0];
 	uint16_t data = 0;
 	int ret = 0;
@@ -1845,11 +1762,6 @@ __weak void OEM_1S_MULTI_ACCURACY_SENSOR_READING(ipmi_msg *msg)
 	***********************************/
 	CHECK_NULL_ARG(msg);
 
-	if (!msg->data_len) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t query_sensor_number = msg->data_len;
 
 	if (query_sensor_number > MAX_MULTI_ACCURACY_SENSOR_READING_QUERY_NUM) {
@@ -1891,15 +1803,168 @@ __weak void OEM_1S_MULTI_ACCURACY_SENSOR_READING(ipmi_msg *msg)
 	msg->completion_code = CC_SUCCESS;
 }
 
-__weak void OEM_1S_CLEAR_CMOS(ipmi_msg *msg)
+__weak void OEM_1S_BULK_SENSOR_READING(ipmi_msg *msg)
 {
+	/*********************************
+	Request -
+	data 0: start sensor number
+	data 1: end sensor number (inclusive)
+	data 2 ~ 33: (optional) sensor number bitmap, bit (n % 8) of byte (n / 8) selects sensor n
+	Response -
+	data 0: next start sensor number, 0xFF if every sensor in range is returned
+	data 1: sensor count N
+	data 2 ~ : N * { sensor number, sensor status, 4 bytes cached reading }
+	***********************************/
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 0) {
+	if ((msg->data_len != 2) && (msg->data_len != (2 + BULK_SENSOR_READING_BITMAP_LEN))) {
 		msg->completion_code = CC_INVALID_LENGTH;
 		return;
 	}
 
+	uint8_t start_num = msg->data[0];
+	uint8_t end_num = msg->data[1];
+	if ((start_num > end_num) || (end_num >= SENSOR_NUM_MAX)) {
+		msg->completion_code = CC_PARAM_OUT_OF_RANGE;
+		return;
+	}
+
+	bool use_bitmap = (msg->data_len != 2);
+	uint8_t bitmap[BULK_SENSOR_READING_BITMAP_LEN];
+	if (use_bitmap) {
+		memcpy(bitmap, &msg->data[2], sizeof(bitmap));
+	}
+
+	uint16_t ofs = BULK_SENSOR_READING_HDR_LEN;
+	uint8_t count = 0;
+	uint16_t num;
+	for (num = start_num; num <= end_num; num++) {
+		if (use_bitmap && !(bitmap[num / 8] & BIT(num % 8))) {
+			continue;
+		}
+
+		/* Skip unconfigured numbers without walking the whole table */
+		if (find_sensor_cfg_via_sensor_num(sensor_config, sensor_config_count, num) ==
+		    NULL) {
+			continue;
+		}
+
+		if ((ofs + sizeof(BULK_SENSOR_READING_ENTRY)) > BULK_SENSOR_READING_RESP_MAX_LEN) {
+			break;
+		}
+
+		BULK_SENSOR_READING_ENTRY entry = { .sensor_num = num, .reading = 0 };
+		if (enable_sensor_poll_thread) {
+			int reading = 0;
+			entry.status = get_sensor_reading(sensor_config, sensor_config_count, num,
+							  &reading, GET_FROM_CACHE);
+			entry.reading = reading;
+		} else {
+			entry.status = SENSOR_POLLING_DISABLE;
+		}
+
+		memcpy(&msg->data[ofs], &entry, sizeof(entry));
+		ofs += sizeof(entry);
+		count++;
+	}
+
+	msg->data[0] = (num <= end_num) ? num : 0xFF;
+	msg->data[1] = count;
+	msg->data_len = ofs;
+	msg->completion_code = CC_SUCCESS;
+}
+
+__weak void OEM_1S_GET_IPMI_QUEUE_STAT(ipmi_msg *msg)
+{
+	/*********************************
+	Request -
+	none
+	Response -
+	data 0 ~ 3: rejected because ipmi_msgq was full, LSB first
+	data 4 ~ 7: rejected because the source was over its in-flight limit, LSB first
+	data 8 ~ 11: dropped on handler timeout, LSB first
+	data 12: ipmi_msgq depth
+	data 13: ipmi_msgq high-water mark
+	data 14 ~ : per lane { busy count LSB first (4 bytes), depth, high-water mark }
+	***********************************/
+	CHECK_NULL_ARG(msg);
+
+	ipmi_msgq_stat stat;
+	if (ipmi_get_msgq_stat(&stat) == false) {
+		msg->completion_code = CC_UNSPECIFIED_ERROR;
+		return;
+	}
+
+	uint8_t ofs = 0;
+	memcpy(&msg->data[ofs], &stat.reject_full, sizeof(uint32_t));
+	ofs += 4;
+	memcpy(&msg->data[ofs], &stat.reject_source, sizeof(uint32_t));
+	ofs += 4;
+	memcpy(&msg->data[ofs], &stat.drop, sizeof(uint32_t));
+	ofs += 4;
+	msg->data[ofs++] = (uint8_t)stat.queue_depth;
+	msg->data[ofs++] = (uint8_t)stat.queue_max;
+
+	ipmi_lane_stat lane;
+	for (uint8_t lane_id = 0; ipmi_get_lane_stat(lane_id, &lane); lane_id++) {
+		memcpy(&msg->data[ofs], &lane.busy, sizeof(uint32_t));
+		ofs += 4;
+		msg->data[ofs++] = (uint8_t)lane.queue_depth;
+		msg->data[ofs++] = (uint8_t)lane.queue_max;
+	}
+
+	msg->data_len = ofs;
+	msg->completion_code = CC_SUCCESS;
+}
+
+__weak void OEM_1S_GET_SENSOR_ENERGY(ipmi_msg *msg)
+{
+	/*********************************
+	Request -
+	data 0: sensor number
+	data 1 ~ 2: average window in seconds, LSB first, 0 means since the first poll
+	Response -
+	data 0 ~ 3: average power over the window, same format as 4-byte accuracy sensor reading
+	data 4 ~ 7: energy since the first poll in the sensor's power unit times seconds, LSB first
+	data 8 ~ 11: window actually covered in milliseconds, LSB first
+	***********************************/
+	CHECK_NULL_ARG(msg);
+
+	uint8_t sensor_num = msg->data[0];
+	uint32_t window_ms = (uint32_t)((msg->data[2] << 8) | msg->data[1]) * 1000;
+	double power = 0, energy = 0;
+	uint32_t span_ms = 0;
+
+	sensor_cfg *cfg =
+		find_sensor_cfg_via_sensor_num(sensor_config, sensor_config_count, sensor_num);
+	if (cfg == NULL) {
+		msg->completion_code = CC_INVALID_DATA_FIELD;
+		return;
+	}
+
+	if ((sensor_energy_get_average_power(cfg, window_ms, &power, &span_ms) != 0) ||
+	    (sensor_energy_get_total(cfg, &energy) != 0)) {
+		// Not an energy sensor or no interval has been polled yet
+		msg->completion_code = CC_SENSOR_NOT_PRESENT;
+		return;
+	}
+
+	sensor_val sval = { 0 };
+	sval.integer = (int16_t)power;
+	sval.fraction = (int16_t)((power - sval.integer) * 1000);
+	uint32_t total = (energy > 0) ? (uint32_t)energy : 0;
+
+	memcpy(&msg->data[0], &sval, sizeof(sval));
+	memcpy(&msg->data[4], &total, sizeof(total));
+	memcpy(&msg->data[8], &span_ms, sizeof(span_ms));
+	msg->data_len = 12;
+	msg->completion_code = CC_SUCCESS;
+}
+
+__weak void OEM_1S_CLEAR_CMOS(ipmi_msg *msg)
+{
+	CHECK_NULL_ARG(msg);
+
 	int ret = pal_clear_cmos();
 
 	if (ret < 0) {
@@ -1922,11 +1987,6 @@ __weak void OEM_1S_APML_READ(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 2) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t apml_bus = apml_get_bus();
 
 	uint8_t read_data;
@@ -1960,11 +2020,6 @@ __weak void OEM_1S_APML_WRITE(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 3) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t apml_bus = apml_get_bus();
 
 	switch (msg->data[0]) {
@@ -1994,11 +2049,6 @@ __weak void OEM_1S_SEND_APML_REQUEST(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len < 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	static uint8_t index = 0;
 	uint8_t apml_bus = apml_get_bus();
 	apml_msg apml_data = { 0 };
@@ -2057,11 +2107,6 @@ __weak void OEM_1S_GET_APML_RESPONSE(ipmi_msg *msg)
 {
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	apml_msg apml_data;
 	if (get_apml_response_by_index(&apml_data, msg->data[0])) {
 		msg->completion_code = CC_UNSPECIFIED_ERROR;
@@ -2097,11 +2142,6 @@ __weak void OEM_1S_NOTIFY_PMIC_ERROR(ipmi_msg *msg)
 
 	CHECK_NULL_ARG(msg);
 
-	if (msg->data_len != 2) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	ret = pal_set_pmic_error_flag(msg->data[0], msg->data[1]);
 
 	switch (ret) {
@@ -2144,11 +2184,6 @@ __weak void OEM_1S_GET_SDR(ipmi_msg *msg)
 	offset = msg->data[4];
 	req_len = msg->data[5];
 
-	if (msg->data_len != 6) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	// If SDR_RSV_ID_check gets false is represent reservation id is incorrect
 	if (SDR_RSV_ID_check(rsv_ID, rsv_table_index) == false) {
 		msg->completion_code = CC_INVALID_RESERVATION;
@@ -2236,11 +2271,6 @@ __weak void OEM_1S_SET_ADD_DEBUG_SEL_MODE(ipmi_msg *msg)
 	uint8_t options;
 	uint8_t status = 0;
 
-	if (msg->data_len < 1) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	options = msg->data[0];
 
 	if (msg->data_len == 2) {
@@ -2376,11 +2406,6 @@ __weak void OEM_1S_SEND_MCTP_PLDM_COMMAND(ipmi_msg *msg)
 	Data 1:N - pldm response data
 	***************************************************/
 
-	if (msg->data_len < 3) {
-		msg->completion_code = CC_INVALID_LENGTH;
-		return;
-	}
-
 	uint8_t resp_buf[PLDM_MAX_DATA_SIZE] = { 0 };
 	pldm_msg pmsg = { 0 };
 	pmsg.hdr.msg_type = MCTP_MSG_TYPE_PLDM;
@@ -2503,348 +2528,236 @@ end:
 }
 #endif
 
-void IPMI_OEM_1S_handler(ipmi_msg *msg)
-{
-	CHECK_NULL_ARG(msg);
-	switch (msg->cmd) {
-	case CMD_OEM_1S_MSG_IN:
-		LOG_DBG("Received 1S Message In command");
-		break;
-	case CMD_OEM_1S_MSG_OUT:
-		LOG_DBG("Received 1S Message Out command");
-		OEM_1S_MSG_OUT(msg);
-		break;
-	case CMD_OEM_1S_GET_GPIO:
-		LOG_DBG("Received 1S Get GPIO command");
-		OEM_1S_GET_GPIO(msg);
-		break;
-	case CMD_OEM_1S_SET_GPIO:
-		LOG_DBG("Received 1S Set GPIO command");
-		break;
-	case CMD_OEM_1S_GET_GPIO_CONFIG:
-		LOG_DBG("Received 1S Get GPIO Config command");
-		OEM_1S_GET_GPIO_CONFIG(msg);
-		break;
-	case CMD_OEM_1S_SET_GPIO_CONFIG:
-		LOG_DBG("Received 1S Get GPIO Config command");
-		OEM_1S_SET_GPIO_CONFIG(msg);
-		break;
-	case CMD_OEM_1S_FW_UPDATE:
-		LOG_DBG("Received 1S Firmware Update command");
-		OEM_1S_FW_UPDATE(msg);
-		break;
-	case CMD_OEM_1S_GET_BIC_FW_INFO:
-		LOG_DBG("Received 1S Get BIC fw info command");
-		OEM_1S_GET_BIC_FW_INFO(msg);
-		break;
-	case CMD_OEM_1S_GET_FW_VERSION:
-		LOG_DBG("Received 1S Get Firmware Version command");
-		OEM_1S_GET_FW_VERSION(msg);
-		break;
-	case CMD_OEM_1S_INFORM_BMC_TO_CONTROL_POWER:
-		LOG_DBG("Receiced 1S Inform BMC to control power command");
-		OEM_1S_INFORM_BMC_TO_CONTROL_POWER(msg);
-		break;
-	case CMD_OEM_1S_RESET_BMC:
-		LOG_DBG("Received 1S BMC Reset command");
-		OEM_1S_RESET_BMC(msg);
-		break;
-	case CMD_OEM_1S_READ_FW_IMAGE:
-		LOG_DBG("Received 1S read fw image command");
-		OEM_1S_READ_FW_IMAGE(msg);
-		break;
-	case CMD_OEM_1S_SET_WDT_FEED:
-		LOG_DBG("Received 1S Set WatchDogTimer Feed command");
-		OEM_1S_SET_WDT_FEED(msg);
-		break;
-	case CMD_OEM_1S_SENSOR_POLL_EN: // debug command
-		LOG_DBG("Received 1S Sensor Poll Enable (Debug) command");
-		OEM_1S_SENSOR_POLL_EN(msg);
-		break;
-	case CMD_OEM_1S_ACCURACY_SENSOR_READING:
-		LOG_DBG("Received 1S Sesnor Reading (Accuracy) command");
-		OEM_1S_ACCURACY_SENSOR_READING(msg);
-		break;
-	case CMD_OEM_1S_GET_SET_GPIO:
-		LOG_DBG("Received 1S Get/Set GPIO command");
-		OEM_1S_GET_SET_GPIO(msg);
-		break;
-	case CMD_OEM_1S_GET_SET_BIC_VGPIO:
-		LOG_DBG("Received 1S Get/Set BIC vGPIO command");
-		OEM_1S_GET_SET_BIC_VGPIO(msg);
-		break;
-	case CMD_OEM_1S_CONTROL_SENSOR_POLLING:
-		LOG_DBG("Received 1S Sensor Polling Control command");
-		OEM_1S_CONTROL_SENSOR_POLLING(msg);
-		break;
-	case CMD_OEM_1S_ERASE_BIOS_FLASH:
-		LOG_DBG("Received 1S Erase BIOS Flash command");
-		OEM_1S_ERASE_BIOS_FLASH(msg);
-		break;
-	case CMD_OEM_1S_GET_BIOS_ERASE_PROGRESS:
-		LOG_DBG("Received 1S GET Erase BIOS Flash Progress command");
-		OEM_1S_GET_BIOS_ERASE_PROGRESS(msg);
-		break;
+/* Common OEM 1S commands, platforms replace or add entries with PLAT_OEM_1S_CMD_DEFINE */
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_MSG_OUT, OEM_1S_MSG_OUT, 0, OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_GPIO, OEM_1S_GET_GPIO, 0, OEM_1S_CMD_MAX_LEN, 0, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_GPIO_CONFIG, OEM_1S_GET_GPIO_CONFIG, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_GPIO_CONFIG, OEM_1S_SET_GPIO_CONFIG, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_FW_UPDATE, OEM_1S_FW_UPDATE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_BIC_FW_INFO, OEM_1S_GET_BIC_FW_INFO, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_FW_VERSION, OEM_1S_GET_FW_VERSION, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_INFORM_BMC_TO_CONTROL_POWER, OEM_1S_INFORM_BMC_TO_CONTROL_POWER, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_RESET_BMC, OEM_1S_RESET_BMC, 0, 0, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_READ_FW_IMAGE, OEM_1S_READ_FW_IMAGE, 6, 6, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_WDT_FEED, OEM_1S_SET_WDT_FEED, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SENSOR_POLL_EN, OEM_1S_SENSOR_POLL_EN, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_ACCURACY_SENSOR_READING, OEM_1S_ACCURACY_SENSOR_READING, 2, 2,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_SET_GPIO, OEM_1S_GET_SET_GPIO, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_SET_BIC_VGPIO, OEM_1S_GET_SET_BIC_VGPIO, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_CONTROL_SENSOR_POLLING, OEM_1S_CONTROL_SENSOR_POLLING, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_ERASE_BIOS_FLASH, OEM_1S_ERASE_BIOS_FLASH, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_BIOS_ERASE_PROGRESS, OEM_1S_GET_BIOS_ERASE_PROGRESS, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
 #ifdef CONFIG_CRYPTO_ASPEED
-	case CMD_OEM_1S_GET_FW_SHA256:
-		LOG_DBG("Received 1S Get Firmware SHA256 command");
-		OEM_1S_GET_FW_SHA256(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_FW_SHA256, OEM_1S_GET_FW_SHA256, 9, 9, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_USER);
 #endif
-	case CMD_OEM_1S_I2C_DEV_SCAN: // debug command
-		LOG_DBG("Received 1S I2C Device Scan (Debug) command");
-		OEM_1S_I2C_DEV_SCAN(msg);
-		break;
-	case CMD_OEM_1S_GET_BIC_STATUS:
-		LOG_DBG("Received 1S Get BIC Status command");
-		OEM_1S_GET_BIC_STATUS(msg);
-		break;
-	case CMD_OEM_1S_SET_VR_MONITOR_STATUS:
-		LOG_DBG("Received 1S Set VR Monitor Status command");
-		OEM_1S_SET_VR_MONITOR_STATUS(msg);
-		break;
-	case CMD_OEM_1S_GET_VR_MONITOR_STATUS:
-		LOG_DBG("Received 1S Get VR Monitor Status command");
-		OEM_1S_GET_VR_MONITOR_STATUS(msg);
-		break;
-	case CMD_OEM_1S_RESET_BIC:
-		LOG_DBG("Received 1S Reset BIC command");
-		OEM_1S_RESET_BIC(msg);
-		break;
-	case CMD_OEM_1S_GET_SET_M2:
-		LOG_DBG("Received 1S Get/Set M2 command");
-		OEM_1S_GET_SET_M2(msg);
-		break;
-	case CMD_OEM_1S_SET_SSD_LED:
-		LOG_DBG("Received 1S Set SSD LED command");
-		OEM_1S_SET_SSD_LED(msg);
-		break;
-	case CMD_OEM_1S_GET_SSD_STATUS:
-		LOG_DBG("Received 1S Get SSD Status command");
-		OEM_1S_GET_SSD_STATUS(msg);
-		break;
-	case CMD_OEM_1S_12V_CYCLE_SLOT:
-		LOG_DBG("Received 1S 12v-Cycle Slot command");
-		OEM_1S_12V_CYCLE_SLOT(msg);
-		break;
-	case CMD_OEM_1S_READ_BIC_REGISTER:
-		LOG_DBG("Received 1S Read BIC Register command");
-		OEM_1S_READ_BIC_REGISTER(msg);
-		break;
-	case CMD_OEM_1S_WRITE_BIC_REGISTER:
-		LOG_DBG("Received 1S Write BIC Register command");
-		OEM_1S_WRITE_BIC_REGISTER(msg);
-		break;
-	case CMD_OEM_1S_CLEAR_CMOS:
-		LOG_DBG("Received 1S Clear CMOS command");
-		OEM_1S_CLEAR_CMOS(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_I2C_DEV_SCAN, OEM_1S_I2C_DEV_SCAN, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_BIC_STATUS, OEM_1S_GET_BIC_STATUS, 0, 0, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_VR_MONITOR_STATUS, OEM_1S_SET_VR_MONITOR_STATUS, 1, 1,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_VR_MONITOR_STATUS, OEM_1S_GET_VR_MONITOR_STATUS, 0, 0,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_RESET_BIC, OEM_1S_RESET_BIC, 0, 0, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_SET_M2, OEM_1S_GET_SET_M2, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_SSD_LED, OEM_1S_SET_SSD_LED, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_SSD_STATUS, OEM_1S_GET_SSD_STATUS, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_12V_CYCLE_SLOT, OEM_1S_12V_CYCLE_SLOT, 0, 0, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_READ_BIC_REGISTER, OEM_1S_READ_BIC_REGISTER, 5, 5,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_WRITE_BIC_REGISTER, OEM_1S_WRITE_BIC_REGISTER, 6, 9,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_CLEAR_CMOS, OEM_1S_CLEAR_CMOS, 0, 0, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
 #ifdef CONFIG_SNOOP_ASPEED
-	case CMD_OEM_1S_GET_POST_CODE:
-		LOG_DBG("Received 1S Get Post Code command");
-		OEM_1S_GET_POST_CODE(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_POST_CODE, OEM_1S_GET_POST_CODE, 0, 0, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_USER);
 #endif
-	case CMD_OEM_1S_GET_4BYTE_POST_CODE:
-		LOG_DBG("Received 1S Get Post Code (4-Byte) command");
-		OEM_1S_GET_4BYTE_POST_CODE(msg);
-		break;
-
-	case CMD_OEM_1S_SET_POSTCODE_FILTER:
-		LOG_DBG("Received 1S Set Postcode Filter command");
-		OEM_1S_SET_POSTCODE_FILTER(msg);
-		break;
-
-	case CMD_OEM_1S_GET_POSTCODE_FILTER:
-		LOG_DBG("Received 1S Get Postcode Filter command");
-		OEM_1S_GET_POSTCODE_FILTER(msg);
-		break;
-
-	case CMD_OEM_1S_GET_FILTERED_AMD_POST_CODE:
-		LOG_DBG("Received 1S Get Filtered AMD Post Code command");
-		OEM_1S_GET_FILTERED_AMD_POST_CODE(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_4BYTE_POST_CODE, OEM_1S_GET_4BYTE_POST_CODE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_POSTCODE_FILTER, OEM_1S_SET_POSTCODE_FILTER, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_POSTCODE_FILTER, OEM_1S_GET_POSTCODE_FILTER, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_FILTERED_AMD_POST_CODE, OEM_1S_GET_FILTERED_AMD_POST_CODE, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
 #ifdef CONFIG_PECI
-	case CMD_OEM_1S_PECI_ACCESS:
-		LOG_DBG("Received 1S Access PECI command");
-		OEM_1S_PECI_ACCESS(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_PECI_ACCESS, OEM_1S_PECI_ACCESS, 3, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
 #endif
 #ifdef ENABLE_APML
-	case CMD_OEM_1S_APML_READ:
-		LOG_DBG("Received 1S APML Read command");
-		OEM_1S_APML_READ(msg);
-		break;
-	case CMD_OEM_1S_APML_WRITE:
-		LOG_DBG("Received 1S APML Write command");
-		OEM_1S_APML_WRITE(msg);
-		break;
-	case CMD_OEM_1S_SEND_APML_REQUEST:
-		LOG_DBG("Received 1S Send APML Request command");
-		OEM_1S_SEND_APML_REQUEST(msg);
-		break;
-	case CMD_OEM_1S_GET_APML_RESPONSE:
-		LOG_DBG("Received 1S Get APML Response command");
-		OEM_1S_GET_APML_RESPONSE(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_APML_READ, OEM_1S_APML_READ, 2, 2, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_APML_WRITE, OEM_1S_APML_WRITE, 3, 3, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SEND_APML_REQUEST, OEM_1S_SEND_APML_REQUEST, 1, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_APML_RESPONSE, OEM_1S_GET_APML_RESPONSE, 1, 1,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
 #endif
 #ifdef CONFIG_JTAG
-	case CMD_OEM_1S_JTAG_TCK_CYCLE:
-		LOG_DBG("Received 1S JTAG TCK cycle command");
-		OEM_1S_JTAG_TCK_CYCLE(msg);
-		break;
-	case CMD_OEM_1S_SET_JTAG_TAP_STA:
-		LOG_DBG("Received 1S Set JTAG Tap Status command");
-		OEM_1S_SET_JTAG_TAP_STA(msg);
-		break;
-	case CMD_OEM_1S_JTAG_DATA_SHIFT:
-		LOG_DBG("Received 1S JTAG Data Shift command");
-		OEM_1S_JTAG_DATA_SHIFT(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_JTAG_TCK_CYCLE, OEM_1S_JTAG_TCK_CYCLE, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_JTAG_TAP_STA, OEM_1S_SET_JTAG_TAP_STA, 2, 2, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_JTAG_DATA_SHIFT, OEM_1S_JTAG_DATA_SHIFT, 5, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
 #ifdef ENABLE_ASD
-	case CMD_OEM_1S_ASD_INIT:
-		LOG_DBG("Received 1S ASD Initialize command");
-		OEM_1S_ASD_INIT(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_ASD_INIT, OEM_1S_ASD_INIT, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_ADMIN);
 #endif
 #endif
 #ifdef ENABLE_FAN
-	case CMD_OEM_1S_SET_FAN_DUTY_AUTO:
-		LOG_DBG("Received 1S Set Fan Duty (Auto) command");
-		OEM_1S_SET_FAN_DUTY_AUTO(msg);
-		break;
-	case CMD_OEM_1S_GET_FAN_DUTY:
-		LOG_DBG("Received 1S Get Fan Duty command");
-		OEM_1S_GET_FAN_DUTY(msg);
-		break;
-	case CMD_OEM_1S_GET_FAN_RPM:
-		LOG_DBG("Received 1S Get Fan RPM command");
-		OEM_1S_GET_FAN_RPM(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_FAN_DUTY_AUTO, OEM_1S_SET_FAN_DUTY_AUTO, 2, 2,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_FAN_DUTY, OEM_1S_GET_FAN_DUTY, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_FAN_RPM, OEM_1S_GET_FAN_RPM, 1, 1, OEM_1S_CMD_MAY_BLOCK,
+		  IPMI_PRIV_USER);
 #endif
-	case CMD_OEM_1S_COPY_FLASH_IMAGE:
-		LOG_DBG("Received 1S Copy Flash Image command");
-		OEM_1S_COPY_FLASH_IMAGE(msg);
-		break;
-	case CMD_GET_COPY_FLASH_STATUS:
-		LOG_DBG("Received 1S Get Copy Flash Status command");
-		GET_COPY_FLASH_STATUS(msg);
-		break;
-	case CMD_OEM_1S_INFORM_PEER_SLED_CYCLE:
-		LOG_DBG("Received 1S Inform Peer Sled-cycle command");
-		OEM_1S_INFORM_PEER_SLED_CYCLE(msg);
-		break;
-	case CMD_OEM_1S_PEX_FLASH_READ:
-		LOG_DBG("Received 1S Read PEX Flash command");
-		OEM_1S_PEX_FLASH_READ(msg);
-		break;
-	case CMD_OEM_1S_GET_FPGA_USER_CODE:
-		LOG_DBG("Received 1S Get FPGA User Code command");
-		OEM_1S_GET_FPGA_USER_CODE(msg);
-		break;
-	case CMD_OEM_1S_GET_BOARD_ID:
-		LOG_DBG("Received 1S Get Board ID command");
-		OEM_1S_GET_BOARD_ID(msg);
-		break;
-	case CMD_OEM_1S_GET_CARD_TYPE:
-		LOG_DBG("Received 1S Get Card Type command");
-		OEM_1S_GET_CARD_TYPE(msg);
-		break;
-	case CMD_OEM_1S_SET_CARD_TYPE:
-		LOG_DBG("Received 1S Set Card Type command");
-		OEM_1S_SET_CARD_TYPE(msg);
-		break;
-	case CMD_OEM_1S_MULTI_ACCURACY_SENSOR_READING:
-		LOG_DBG("Received 1S Multi-accuracy Sensor Read command");
-		OEM_1S_MULTI_ACCURACY_SENSOR_READING(msg);
-		break;
-	case CMD_OEM_1S_BRIDGE_I2C_MSG_BY_COMPNT:
-		LOG_DBG("Received 1S Bridge I2C Message by Component command");
-		OEM_1S_BRIDGE_I2C_MSG_BY_COMPNT(msg);
-		break;
-	case CMD_OEM_1S_NOTIFY_PMIC_ERROR:
-		LOG_DBG("Received 1S Notify PMIC Error command");
-		OEM_1S_NOTIFY_PMIC_ERROR(msg);
-		break;
-	case CMD_OEM_1S_GET_SDR:
-		LOG_DBG("Received 1S Get SDR command");
-		OEM_1S_GET_SDR(msg);
-		break;
-	case CMD_OEM_1S_BMC_IPMB_ACCESS:
-		LOG_DBG("Received 1S BMC IPMB Access command");
-		OEM_1S_BMC_IPMB_ACCESS(msg);
-		break;
-	case CMD_OEM_1S_GET_HSC_STATUS:
-		LOG_DBG("Received 1S Get HSC Status command");
-		OEM_1S_GET_HSC_STATUS(msg);
-		break;
-	case CMD_OEM_1S_GET_BIOS_VERSION:
-		LOG_DBG("Received 1S Get BIOS version command");
-		OEM_1S_GET_BIOS_VERSION(msg);
-		break;
-	case CMD_OEM_1S_GET_PCIE_CARD_STATUS:
-		LOG_DBG("Received 1S Get PCIE card status command");
-		OEM_1S_GET_PCIE_CARD_STATUS(msg);
-		break;
-	case CMD_OEM_1S_GET_PCIE_CARD_SENSOR_READING:
-		LOG_DBG("Received 1S Get PCIE card sensor reading command");
-		OEM_1S_GET_PCIE_CARD_SENSOR_READING(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_COPY_FLASH_IMAGE, OEM_1S_COPY_FLASH_IMAGE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_GET_COPY_FLASH_STATUS, GET_COPY_FLASH_STATUS, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_INFORM_PEER_SLED_CYCLE, OEM_1S_INFORM_PEER_SLED_CYCLE, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_PEX_FLASH_READ, OEM_1S_PEX_FLASH_READ, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_FPGA_USER_CODE, OEM_1S_GET_FPGA_USER_CODE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_BOARD_ID, OEM_1S_GET_BOARD_ID, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_CARD_TYPE, OEM_1S_GET_CARD_TYPE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_CARD_TYPE, OEM_1S_SET_CARD_TYPE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_MULTI_ACCURACY_SENSOR_READING, OEM_1S_MULTI_ACCURACY_SENSOR_READING, 1,
+		  OEM_1S_CMD_MAX_LEN, 0, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_BULK_SENSOR_READING, OEM_1S_BULK_SENSOR_READING, 2,
+		  2 + BULK_SENSOR_READING_BITMAP_LEN, 0, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_IPMI_QUEUE_STAT, OEM_1S_GET_IPMI_QUEUE_STAT, 0, 0, 0,
+		  IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_SENSOR_ENERGY, OEM_1S_GET_SENSOR_ENERGY, 3, 3, 0,
+		  IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_BRIDGE_I2C_MSG_BY_COMPNT, OEM_1S_BRIDGE_I2C_MSG_BY_COMPNT, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_NOTIFY_PMIC_ERROR, OEM_1S_NOTIFY_PMIC_ERROR, 2, 2,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_SDR, OEM_1S_GET_SDR, 6, 6, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_BMC_IPMB_ACCESS, OEM_1S_BMC_IPMB_ACCESS, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_HSC_STATUS, OEM_1S_GET_HSC_STATUS, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_BIOS_VERSION, OEM_1S_GET_BIOS_VERSION, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_PCIE_CARD_STATUS, OEM_1S_GET_PCIE_CARD_STATUS, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_PCIE_CARD_SENSOR_READING, OEM_1S_GET_PCIE_CARD_SENSOR_READING, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
 #ifdef CONFIG_I3C_ASPEED
-	case CMD_OEM_1S_WRITE_READ_DIMM:
-		LOG_DBG("Received 1S write read dimm information command");
-		OEM_1S_WRITE_READ_DIMM(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_WRITE_READ_DIMM, OEM_1S_WRITE_READ_DIMM, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
 #endif
-	case CMD_OEM_1S_GET_DIMM_I3C_MUX_SELECTION:
-		LOG_DBG("Received 1S Get DIMM I3C MUX selection command");
-		OEM_1S_GET_DIMM_I3C_MUX_SELECTION(msg);
-		break;
-	case CMD_OEM_1S_SAFE_WRITE_READ_M2_DATA:
-		LOG_DBG("Received 1S write read M.2 data command");
-		OEM_1S_SAFE_WRITE_READ_M2_DATA(msg);
-		break;
-	case CMD_OEM_1S_PRE_POWER_OFF_CONTROL:
-		LOG_DBG("Received 1S PRE POWER OFF CONTROL command");
-		OEM_1S_PRE_POWER_OFF_CONTROL(msg);
-		break;
-	case CMD_OEM_1S_SET_DEVICE_ACTIVE:
-		LOG_DBG("Received 1S SET DEVICE ACTIVE command");
-		OEM_1S_SET_DEVICE_ACTIVE(msg);
-		break;
-	case CMD_OEM_1S_SET_ADD_DEBUG_SEL_MODE:
-		LOG_DBG("Received SET ADD DEBUG SEL MODE command");
-		OEM_1S_SET_ADD_DEBUG_SEL_MODE(msg);
-		break;
-	case CMD_OEM_1S_GET_PCIE_RETIMER_TYPE:
-		LOG_DBG("Received GET PCIE RETIMER TYPE command");
-		OEM_1S_GET_PCIE_RETIMER_TYPE(msg);
-		break;
-	case CMD_OEM_1S_DEBUG_GET_HW_SIGNAL:
-		LOG_DBG("Received DEBUG GET HW SIGNAL command");
-		OEM_1S_DEBUG_GET_HW_SIGNAL(msg);
-		break;
-	case CMD_OEM_1S_SEND_MCTP_PLDM_COMMAND:
-		LOG_DBG("Received MCTP-PLDM command");
-		OEM_1S_SEND_MCTP_PLDM_COMMAND(msg);
-		break;
-	case CMD_OEM_1S_CLEAR_CMET:
-		LOG_DBG("Received CLEAR CMET command");
-		OEM_1S_CLEAR_CMET(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_DIMM_I3C_MUX_SELECTION, OEM_1S_GET_DIMM_I3C_MUX_SELECTION, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SAFE_WRITE_READ_M2_DATA, OEM_1S_SAFE_WRITE_READ_M2_DATA, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_PRE_POWER_OFF_CONTROL, OEM_1S_PRE_POWER_OFF_CONTROL, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_DEVICE_ACTIVE, OEM_1S_SET_DEVICE_ACTIVE, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SET_ADD_DEBUG_SEL_MODE, OEM_1S_SET_ADD_DEBUG_SEL_MODE, 1,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_GET_PCIE_RETIMER_TYPE, OEM_1S_GET_PCIE_RETIMER_TYPE, 0,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_DEBUG_GET_HW_SIGNAL, OEM_1S_DEBUG_GET_HW_SIGNAL, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_USER);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SEND_MCTP_PLDM_COMMAND, OEM_1S_SEND_MCTP_PLDM_COMMAND, 3,
+		  OEM_1S_CMD_MAX_LEN, OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_CLEAR_CMET, OEM_1S_CLEAR_CMET, 0, OEM_1S_CMD_MAX_LEN,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_OPERATOR);
 #ifdef CONFIG_SPI_ASPEED
-	case CMD_OEM_1S_SPI_REGISTER_READ:
-		LOG_DBG("Received SPI REGISTER READ command");
-		OEM_1S_SPI_REGISTER_READ(msg);
-		break;
+OEM_1S_CMD_DEFINE(CMD_OEM_1S_SPI_REGISTER_READ, OEM_1S_SPI_REGISTER_READ, 3, 3,
+		  OEM_1S_CMD_MAY_BLOCK, IPMI_PRIV_ADMIN);
 #endif
-	default:
+
+static const struct oem_1s_cmd_entry *oem_1s_cmd_idx[UINT8_MAX + 1];
+
+void oem_1s_cmd_table_init(void)
+{
+	memset(oem_1s_cmd_idx, 0, sizeof(oem_1s_cmd_idx));
+
+	Z_STRUCT_SECTION_FOREACH(oem_1s_cmd_entry, entry)
+	{
+		if (oem_1s_cmd_idx[entry->cmd] != NULL) {
+			LOG_DBG("OEM 1S cmd 0x%x handler replaced by platform", entry->cmd);
+		}
+		oem_1s_cmd_idx[entry->cmd] = entry;
+	}
+}
+
+const struct oem_1s_cmd_entry *oem_1s_cmd_find(uint8_t cmd)
+{
+	return oem_1s_cmd_idx[cmd];
+}
+
+/* Every interface is trusted by default, platforms may lower the privilege of e.g. the host */
+__weak uint8_t pal_get_ipmi_source_priv(uint8_t source)
+{
+	return IPMI_PRIV_ADMIN;
+}
+
+void IPMI_OEM_1S_handler(ipmi_msg *msg)
+{
+	CHECK_NULL_ARG(msg);
+
+	const struct oem_1s_cmd_entry *entry = oem_1s_cmd_find(msg->cmd);
+	if (entry == NULL) {
 		LOG_ERR("Invalid OEM message, netfn(0x%x) cmd(0x%x)", msg->netfn, msg->cmd);
 		msg->data_len = 0;
 		msg->completion_code = CC_INVALID_CMD;
-		break;
+		return;
 	}
-	return;
+
+	if ((msg->data_len < entry->min_len) || (msg->data_len > entry->max_len)) {
+		LOG_DBG("OEM 1S cmd 0x%x invalid length %d", msg->cmd, msg->data_len);
+		msg->data_len = 0;
+		msg->completion_code = CC_INVALID_LENGTH;
+		return;
+	}
+
+	if (pal_get_ipmi_source_priv(msg->InF_source) < entry->priv) {
+		LOG_WRN("OEM 1S cmd 0x%x not allowed from source 0x%x", msg->cmd, msg->InF_source);
+		msg->data_len = 0;
+		msg->completion_code = CC_INSUFFICIENT_PRIVILEGE;
+		return;
+	}
+
+	LOG_DBG("Received 1S command 0x%x", msg->cmd);
+	entry->handler(msg);
 }
 
 __weak void OEM_1S_RECORD_DAM_PIN_STATUS(uint8_t gpio_num, uint8_t status)
@@ -163,48 +163,96 @@ static uint8_t bridge_msg(mctp *mctp_inst, uint8_t *buf, uint16_t len)
 	return mctp_bridge_msg(target_mctp, buf, len, target_ext_params);
 }
 
-static uint8_t mctp_pkt_assembling(mctp *mctp_inst, uint8_t *buf, uint16_t len)
+static mctp_rx_buf *mctp_rx_buf_get(mctp *mctp_inst)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, NULL);
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst->rx_pool, NULL);
+
+	for (uint8_t i = 0; i < MCTP_RX_POOL_NUM; i++) {
+		if (atomic_cas(&mctp_inst->rx_pool[i].ref, 0, 1)) {
+			mctp_inst->rx_pool[i].len = 0;
+			return &mctp_inst->rx_pool[i];
+		}
+	}
+
+	return NULL;
+}
+
+static void mctp_rx_buf_put(mctp_rx_buf *rx_buf)
+{
+	CHECK_NULL_ARG(rx_buf);
+
+	atomic_dec(&rx_buf->ref);
+}
+
+static void mctp_drop_assembly(mctp *mctp_inst, uint8_t msg_tag, uint8_t to)
+{
+	CHECK_NULL_ARG(mctp_inst);
+
+	mctp_rx_buf **asm_p = &mctp_inst->temp_msg_buf[msg_tag][to];
+	if (*asm_p) {
+		mctp_rx_buf_put(*asm_p);
+		*asm_p = NULL;
+	}
+}
+
+/*
+ * The SOM packet of a multi-packet message is kept in place as the assembly buffer, in that
+ * case *rx_buf_p is replaced with a fresh buffer for the next medium read.
+ */
+static uint8_t mctp_pkt_assembling(mctp *mctp_inst, mctp_rx_buf **rx_buf_p, uint16_t len)
 {
 	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, MCTP_ERROR);
-	CHECK_NULL_ARG_WITH_RETURN(buf, MCTP_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(rx_buf_p, MCTP_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(*rx_buf_p, MCTP_ERROR);
 	CHECK_ARG_WITH_RETURN(!len, MCTP_ERROR);
 
-	mctp_hdr *hdr = (mctp_hdr *)buf;
-	uint8_t **buf_p = &mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf;
-	uint16_t *offset_p = &mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].offset;
+	mctp_rx_buf *rx_buf = *rx_buf_p;
+	mctp_hdr *hdr = (mctp_hdr *)rx_buf->data;
+	mctp_rx_buf **asm_p = &mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to];
+	uint16_t payload_len = len - sizeof(mctp_hdr);
 
 	/* one packet message, do nothing */
-	if (hdr->som && hdr->eom)
+	if (hdr->som && hdr->eom) {
+		if (*asm_p) {
+			LOG_WRN("Unexpected SOM received?");
+			mctp_drop_assembly(mctp_inst, hdr->msg_tag, hdr->to);
+		}
 		return MCTP_SUCCESS;
-	/* first packet, allocate memory to hold data */
+	}
+	/* first packet, keep it in place and take another buffer for the next read */
 	if (hdr->som && !hdr->eom) {
-		if (*buf_p) {
+		if (*asm_p) {
 			LOG_WRN("Unexpected SOM received?");
-			free(*buf_p);
+			mctp_drop_assembly(mctp_inst, hdr->msg_tag, hdr->to);
 		}
-		*offset_p = 0;
 
-		*buf_p = (uint8_t *)malloc(MSG_ASSEMBLY_BUF_SIZE);
-		if (!*buf_p) {
-			LOG_WRN("cannot create memory...");
+		mctp_rx_buf *next = mctp_rx_buf_get(mctp_inst);
+		if (!next) {
+			LOG_WRN("no free rx buffer to assemble msg_tag %d", hdr->msg_tag);
 			return MCTP_ERROR;
 		}
-		memset(*buf_p, 0, MSG_ASSEMBLY_BUF_SIZE);
+
+		rx_buf->len = payload_len;
+		*asm_p = rx_buf;
+		*rx_buf_p = next;
+		return MCTP_SUCCESS;
 	}
 
-	if (!(*buf_p)) {
-		LOG_HEXDUMP_WRN(buf, len, "There was no SOM package before?");
+	if (!(*asm_p)) {
+		LOG_HEXDUMP_WRN(rx_buf->data, len, "There was no SOM package before?");
 		return MCTP_ERROR;
 	}
 
-	uint16_t offset_new = *offset_p + len - sizeof(mctp_hdr);
+	uint16_t offset_new = (*asm_p)->len + payload_len;
 	if (offset_new > MSG_ASSEMBLY_BUF_SIZE) {
 		LOG_WRN("assembly size %d over buffer size %d", offset_new, MSG_ASSEMBLY_BUF_SIZE);
 		return MCTP_ERROR;
 	}
 	/* Appending other packet after the first packet */
-	memcpy(*buf_p + *offset_p, buf + sizeof(mctp_hdr), len - sizeof(mctp_hdr));
-	*offset_p = offset_new;
+	memcpy((*asm_p)->data + sizeof(mctp_hdr) + (*asm_p)->len, rx_buf->data + sizeof(mctp_hdr),
+	       payload_len);
+	(*asm_p)->len = offset_new;
 	return MCTP_SUCCESS;
 }
 
@@ -223,18 +271,40 @@ static void mctp_rx_task(void *arg, void *dummy0, void *dummy1)
 
 	LOG_INF("mctp_rx_task start %p", mctp_inst);
 
+	mctp_rx_buf *rx_buf = NULL;
 	while (1) {
-		k_msleep(MCTP_POLL_TIME_MS);
-		uint8_t read_buf[256] = { 0 };
+		if (!rx_buf) {
+			rx_buf = mctp_rx_buf_get(mctp_inst);
+			if (!rx_buf) {
+				/* every buffer is holding a message being assembled */
+				k_msleep(MCTP_POLL_TIME_MS);
+				continue;
+			}
+		}
+
+		uint8_t *read_buf = rx_buf->data;
 		mctp_ext_params ext_params;
 		uint8_t ret = MCTP_ERROR;
 		memset(&ext_params, 0, sizeof(ext_params));
 
-		uint16_t read_len =
-			mctp_inst->read_data(mctp_inst, read_buf, sizeof(read_buf), &ext_params);
+		uint16_t read_len = mctp_inst->read_data(mctp_inst, read_buf, sizeof(rx_buf->data),
+							 &ext_params);
+		mctp_inst->rx_wakeup_cnt++;
 
-		if (!read_len)
+		/*
+		 * SMBus target and I3C IBI reads block until a frame lands, so only back off
+		 * when the medium had nothing pending (polled mediums) or the read failed.
+		 */
+		if (!read_len) {
+			k_msleep(MCTP_POLL_TIME_MS);
 			continue;
+		}
+		mctp_inst->rx_frame_cnt++;
+
+		if (read_len < sizeof(mctp_hdr)) {
+			LOG_HEXDUMP_WRN(read_buf, read_len, "mctp packet too short");
+			continue;
+		}
 
 		LOG_HEXDUMP_DBG(read_buf, read_len, "mctp receive data");
 
@@ -260,15 +330,18 @@ static void mctp_rx_task(void *arg, void *dummy0, void *dummy1)
 		}
 
 		/* handle this packet by self */
+		uint8_t msg_tag = hdr->msg_tag;
+		uint8_t to = hdr->to;
+		uint8_t eom = hdr->eom;
 
-		/* assembling the mctp message */
-		if (mctp_pkt_assembling(mctp_inst, read_buf, read_len) == MCTP_ERROR) {
+		/* assembling the mctp message, rx_buf may be swapped out if it holds a SOM */
+		if (mctp_pkt_assembling(mctp_inst, &rx_buf, read_len) == MCTP_ERROR) {
 			LOG_WRN("Packet assemble failed ");
 			goto error;
 		}
 
 		/* if it is not last packet, waiting for the remain data */
-		if (!hdr->eom)
+		if (!eom)
 			continue;
 
 		if (mctp_inst->rx_cb) {
@@ -276,23 +349,20 @@ static void mctp_rx_task(void *arg, void *dummy0, void *dummy1)
 			uint8_t *p = read_buf + sizeof(mctp_hdr);
 			uint16_t len = read_len - sizeof(mctp_hdr);
 			/* this is assembly message */
-			if (mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf) {
-				p = mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf;
-				len = mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].offset;
+			mctp_rx_buf *asm_buf = mctp_inst->temp_msg_buf[msg_tag][to];
+			if (asm_buf) {
+				p = asm_buf->data + sizeof(mctp_hdr);
+				len = asm_buf->len;
 
 				LOG_HEXDUMP_DBG(p, len, "mctp assembly data");
 			}
 
-			/* handle the mctp messsage */
+			/* handle the mctp messsage, no copy is made of the pool buffer */
 			mctp_inst->rx_cb(mctp_inst, p, len, ext_params);
 		}
 
 	error:
-		if (mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf) {
-			free(mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf);
-			mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].buf = NULL;
-			mctp_inst->temp_msg_buf[hdr->msg_tag][hdr->to].offset = 0;
-		}
+		mctp_drop_assembly(mctp_inst, msg_tag, to);
 	}
 }
 
@@ -332,7 +402,6 @@ static void mctp_tx_task(void *arg, void *dummy0, void *dummy1)
 		}
 
 		if (!mctp_msg.len) {
-			free(mctp_msg.buf);
 			mctp_tx_task_response(mctp_msg.evt_msgq, MCTP_ERROR);
 			continue;
 		}
@@ -347,7 +416,6 @@ static void mctp_tx_task(void *arg, void *dummy0, void *dummy1)
 		if (mctp_msg.is_bridge_packet) {
 			ret = mctp_inst->write_data(mctp_inst, mctp_msg.buf, mctp_msg.len,
 						    mctp_msg.ext_params);
-			free(mctp_msg.buf);
 			mctp_tx_task_response(mctp_msg.evt_msgq, ret);
 			if (pal_is_need_mctp_interval(mctp_inst)) {
 				k_msleep(pal_get_mctp_interval_ms(mctp_inst));
@@ -410,7 +478,6 @@ static void mctp_tx_task(void *arg, void *dummy0, void *dummy1)
 			}
 		}
 
-		free(mctp_msg.buf);
 		mctp_tx_task_response(mctp_msg.evt_msgq,
 				      (i == split_pkt_num) ? MCTP_SUCCESS : MCTP_ERROR);
 
@@ -513,6 +580,9 @@ uint8_t mctp_stop(mctp *mctp_inst)
 		mctp_inst->mctp_tx_queue.buffer_start = NULL;
 	}
 
+	memset(mctp_inst->temp_msg_buf, 0, sizeof(mctp_inst->temp_msg_buf));
+	SAFE_FREE(mctp_inst->rx_pool);
+
 	mctp_inst->is_servcie_start = 0;
 	return MCTP_SUCCESS;
 }
@@ -536,6 +606,12 @@ uint8_t mctp_start(mctp *mctp_inst)
 
 	k_msgq_init(&mctp_inst->mctp_tx_queue, msgq_buf, sizeof(mctp_tx_msg), MCTP_TX_QUEUE_SIZE);
 
+	mctp_inst->rx_pool = (mctp_rx_buf *)calloc(MCTP_RX_POOL_NUM, sizeof(mctp_rx_buf));
+	if (!mctp_inst->rx_pool) {
+		LOG_WRN("rx pool alloc failed!!");
+		goto error;
+	}
+
 	/* create rx service */
 	mctp_inst->mctp_rx_task_tid =
 		k_thread_create(&mctp_inst->rx_task_thread_data, mctp_inst->rx_task_stack_area,
@@ -577,14 +653,11 @@ static uint8_t mctp_pass_tx_task(mctp *mctp_inst, uint8_t *buf, uint16_t len,
 		return MCTP_ERROR;
 	}
 
+	/* buf is passed by reference, this function blocks until the tx task is done with it */
 	mctp_tx_msg mctp_msg = { 0 };
 	mctp_msg.is_bridge_packet = is_bridge;
 	mctp_msg.len = len;
-	mctp_msg.buf = (uint8_t *)malloc(len);
-	if (!mctp_msg.buf)
-		goto error;
-	memcpy(mctp_msg.buf, buf, len);
-
+	mctp_msg.buf = buf;
 	mctp_msg.ext_params = ext_params;
 
 	/* create msg queue for catching the return code from mctp_tx_task */
@@ -599,16 +672,12 @@ static uint8_t mctp_pass_tx_task(mctp *mctp_inst, uint8_t *buf, uint16_t len,
 		uint8_t evt = MCTP_ERROR;
 		if (k_msgq_get(&evt_msgq, &evt, K_FOREVER)) {
 			LOG_WRN("failed to get status from msgq!");
-			goto error;
+			return MCTP_ERROR;
 		}
 
 		return evt;
 	}
 
-error:
-	if (mctp_msg.buf)
-		free(mctp_msg.buf);
-
 	return MCTP_ERROR;
 }
 
@@ -38,6 +38,12 @@ extern "C" {
 
 #define MSG_ASSEMBLY_BUF_SIZE 1024
 
+#ifdef PLAT_MCTP_RX_POOL_NUM
+#define MCTP_RX_POOL_NUM PLAT_MCTP_RX_POOL_NUM
+#else
+#define MCTP_RX_POOL_NUM 4
+#endif
+
 #define MCTP_RX_TASK_STACK_SIZE 4096
 #define MCTP_TX_TASK_STACK_SIZE 2048
 #define MCTP_TASK_NAME_LEN 32
@@ -145,10 +151,21 @@ typedef union {
 	mctp_i3c_conf i3c_conf;
 } mctp_medium_conf;
 
+/*
+ * mctp rx buffer, the medium reads a packet straight into data and a multi-packet message is
+ * assembled in the buffer that received its SOM packet, so the payload starts at
+ * data + MCTP_TRANSPORT_HEADER_SIZE in both cases
+ */
+typedef struct _mctp_rx_buf {
+	atomic_t ref; /* 0 means free */
+	uint16_t len; /* assembled payload length */
+	uint8_t data[MCTP_TRANSPORT_HEADER_SIZE + MSG_ASSEMBLY_BUF_SIZE];
+} mctp_rx_buf;
+
 /* mctp tx message struct */
 typedef struct __attribute__((aligned(4))) {
 	uint8_t is_bridge_packet;
-	uint8_t *buf;
+	uint8_t *buf; /* owned by the sender, which blocks until the tx task responds */
 	uint16_t len;
 	mctp_ext_params ext_params;
 	struct k_msgq *evt_msgq;
@@ -179,14 +196,18 @@ typedef struct _mctp {
 	uint8_t mctp_rx_task_name[MCTP_TASK_NAME_LEN];
 	uint8_t mctp_tx_task_name[MCTP_TASK_NAME_LEN];
 
+	/* rx task statistics, wakeups against frames received */
+	uint32_t rx_wakeup_cnt;
+	uint32_t rx_frame_cnt;
+
 	/* write queue */
 	struct k_msgq mctp_tx_queue;
 
+	/* rx buffer pool, allocated on mctp_start */
+	mctp_rx_buf *rx_pool;
+
 	/* point to the rx message buffer that is assembling request/response */
-	struct {
-		uint8_t *buf;
-		uint16_t offset;
-	} temp_msg_buf[MCTP_MAX_MSG_TAG_NUM][2];
+	mctp_rx_buf *temp_msg_buf[MCTP_MAX_MSG_TAG_NUM][2];
 
 	/* the callback when recevie mctp data */
 	mctp_fn_cb rx_cb;
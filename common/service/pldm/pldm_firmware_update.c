@@ -40,6 +40,7 @@
 #include "mp2988.h"
 #include "mp29816a.h"
 #include "raa228249.h"
+#include "util_pmbus.h"
 
 LOG_MODULE_DECLARE(pldm);
 
@@ -344,6 +345,9 @@ uint8_t pldm_vr_update(void *fw_update_param)
 
 	ret = 0;
 exit:
+	// New firmware (or a half written one) may come up with different static settings
+	pmbus_reg_cache_invalidate(p->bus, p->addr);
+	pmbus_page_cache_invalidate(p->bus, p->addr);
 	SAFE_FREE(hex_buff);
 	return ret;
 }
@@ -788,6 +792,139 @@ static pldm_fw_update_info_t *find_update_info(uint16_t comp_id)
 	return NULL;
 }
 
+static uint32_t fw_update_kbps(uint32_t bytes, int64_t elapsed_ms)
+{
+	if (elapsed_ms <= 0)
+		return 0;
+
+	return (uint32_t)(((uint64_t)bytes * 1000 / 1024) / elapsed_ms);
+}
+
+/* Clamp a RequestFirmwareData request to the UA limits, return the length update_func expects */
+static uint32_t fw_update_clamp_request(struct pldm_request_firmware_data_req *req)
+{
+	CHECK_NULL_ARG_WITH_RETURN(req, 0);
+
+	uint32_t expect_len = req->length;
+
+	if (req->offset + req->length >
+	    fw_update_cfg.image_size + MIN_FW_UPDATE_BASELINE_TRANS_SIZE) {
+		LOG_WRN("Request length over UA padding limit count 0x%x",
+			MIN_FW_UPDATE_BASELINE_TRANS_SIZE);
+		req->length = fw_update_cfg.image_size - req->offset;
+		expect_len = req->length;
+	}
+	if (req->length <= MIN_FW_UPDATE_BASELINE_TRANS_SIZE) {
+		LOG_WRN("Request length smaller than baseline size, modify it from 0x%x to 0x%x",
+			req->length, MIN_FW_UPDATE_BASELINE_TRANS_SIZE);
+		req->length = MIN_FW_UPDATE_BASELINE_TRANS_SIZE;
+	} else if (req->length > fw_update_cfg.max_buff_size) {
+		LOG_WRN("Request length larger than maximum size, modify it from 0x%x to 0x%x",
+			req->length, fw_update_cfg.max_buff_size);
+		req->length = fw_update_cfg.max_buff_size;
+		expect_len = req->length;
+	} else {
+		expect_len = req->length;
+	}
+
+	return expect_len;
+}
+
+#ifdef ENABLE_PLDM_FW_UPDATE_PIPELINE
+/*
+ * While update_func programs the current chunk, the prefetch thread already requests the chunk
+ * that follows it. The prefetch is used only if update_func then asks for that same offset; the
+ * request is sized up to max_buff_size, and a shorter next_len just uses a prefix of it.
+ */
+#define PLDM_FW_PREFETCH_STACK_SIZE 2048
+
+static struct {
+	void *mctp_p;
+	void *ext_params;
+	struct pldm_request_firmware_data_req req;
+	uint32_t expect_len;
+	uint8_t *buf;
+	uint16_t read_len;
+	bool pending;
+} fw_prefetch;
+
+K_THREAD_STACK_DEFINE(pldm_fw_prefetch_stack, PLDM_FW_PREFETCH_STACK_SIZE);
+static struct k_thread pldm_fw_prefetch_thread;
+static k_tid_t fw_prefetch_tid;
+K_SEM_DEFINE(fw_prefetch_start_sem, 0, 1);
+K_SEM_DEFINE(fw_prefetch_done_sem, 0, 1);
+
+static void fw_prefetch_handler(void *arg0, void *arg1, void *arg2)
+{
+	ARG_UNUSED(arg0);
+	ARG_UNUSED(arg1);
+	ARG_UNUSED(arg2);
+
+	while (1) {
+		k_sem_take(&fw_prefetch_start_sem, K_FOREVER);
+		fw_prefetch.read_len =
+			pldm_fw_update_read(fw_prefetch.mctp_p,
+					    PLDM_FW_UPDATE_CMD_CODE_REQUEST_FIRMWARE_DATA,
+					    (uint8_t *)&fw_prefetch.req,
+					    sizeof(struct pldm_request_firmware_data_req),
+					    fw_prefetch.buf, fw_prefetch.req.length + 1,
+					    fw_prefetch.ext_params);
+		k_sem_give(&fw_prefetch_done_sem);
+	}
+}
+
+static void fw_prefetch_start(void *mctp_p, void *ext_params, uint32_t offset, uint8_t *buf)
+{
+	CHECK_NULL_ARG(buf);
+
+	if (offset >= fw_update_cfg.image_size)
+		return;
+
+	if (!fw_prefetch_tid) {
+		fw_prefetch_tid = k_thread_create(&pldm_fw_prefetch_thread, pldm_fw_prefetch_stack,
+						  K_THREAD_STACK_SIZEOF(pldm_fw_prefetch_stack),
+						  fw_prefetch_handler, NULL, NULL, NULL,
+						  CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		k_thread_name_set(&pldm_fw_prefetch_thread, "pldm_fw_prefetch_thread");
+	}
+
+	fw_prefetch.mctp_p = mctp_p;
+	fw_prefetch.ext_params = ext_params;
+	fw_prefetch.buf = buf;
+	fw_prefetch.req.offset = offset;
+	fw_prefetch.req.length =
+		MIN(fw_update_cfg.max_buff_size, fw_update_cfg.image_size - offset);
+	fw_prefetch.expect_len = fw_update_clamp_request(&fw_prefetch.req);
+	fw_prefetch.pending = true;
+	k_sem_give(&fw_prefetch_start_sem);
+}
+
+/* Wait for the outstanding prefetch, return its data if it covers the given request */
+static uint8_t *fw_prefetch_collect(const struct pldm_request_firmware_data_req *req,
+				    uint32_t expect_len)
+{
+	if (!fw_prefetch.pending)
+		return NULL;
+
+	k_sem_take(&fw_prefetch_done_sem, K_FOREVER);
+	fw_prefetch.pending = false;
+
+	if (!req || (fw_prefetch.req.offset != req->offset) ||
+	    (fw_prefetch.expect_len < expect_len) ||
+	    (fw_prefetch.read_len != (fw_prefetch.req.length + 1)) ||
+	    (fw_prefetch.buf[0] != PLDM_SUCCESS)) {
+		LOG_DBG("Prefetch at 0x%x discarded", fw_prefetch.req.offset);
+		return NULL;
+	}
+
+	return fw_prefetch.buf;
+}
+
+#define PLDM_FW_UPDATE_BUF_NUM 2
+#else
+#define PLDM_FW_UPDATE_BUF_NUM 1
+#endif
+
 void req_fw_update_handler(void *mctp_p, void *ext_params, void *arg)
 {
 	ARG_UNUSED(arg);
@@ -817,6 +954,7 @@ void req_fw_update_handler(void *mctp_p, void *ext_params, void *arg)
 		}
 	}
 
+	uint8_t *data_buf[PLDM_FW_UPDATE_BUF_NUM] = { NULL };
 	pldm_fw_update_param_t update_param = { 0 };
 	update_param.comp_id = cur_update_comp_id;
 	update_param.comp_version_str = cur_update_comp_str;
@@ -834,10 +972,24 @@ void req_fw_update_handler(void *mctp_p, void *ext_params, void *arg)
 	struct pldm_request_firmware_data_req req = { .offset = 0,
 						      .length = fw_update_cfg.max_buff_size };
 
+	uint16_t data_buf_size =
+		MAX(fw_update_cfg.max_buff_size, MIN_FW_UPDATE_BASELINE_TRANS_SIZE);
+	for (uint8_t i = 0; i < PLDM_FW_UPDATE_BUF_NUM; i++) {
+		data_buf[i] = malloc(data_buf_size + 1);
+		if (!data_buf[i]) {
+			LOG_ERR("Allocate firmware data buffer failed");
+			cur_aux_state = STATE_AUX_FAILED;
+			goto exit;
+		}
+	}
+
 	cur_aux_state = STATE_AUX_INPROGRESS;
 
 	uint32_t last_offset = 0xFFFFFFFF;
 	uint8_t retry_count = 0;
+	uint8_t cur_buf = 0;
+	uint32_t recv_bytes = 0;
+	int64_t start_ms = k_uptime_get();
 
 	do {
 		if (keep_update_flag == false) {
@@ -847,89 +999,91 @@ void req_fw_update_handler(void *mctp_p, void *ext_params, void *arg)
 		}
 
 		/* check request data length */
-		uint32_t expect_len = req.length;
-
-		if (req.offset + req.length >
-		    fw_update_cfg.image_size + MIN_FW_UPDATE_BASELINE_TRANS_SIZE) {
-			LOG_WRN("Request length over UA padding limit count 0x%x",
-				MIN_FW_UPDATE_BASELINE_TRANS_SIZE);
-			req.length = fw_update_cfg.image_size - req.offset;
-			expect_len = req.length;
-		}
-		if (req.length <= MIN_FW_UPDATE_BASELINE_TRANS_SIZE) {
-			LOG_WRN("Request length smaller than baseline size, modify it from 0x%x to 0x%x",
-				req.length, MIN_FW_UPDATE_BASELINE_TRANS_SIZE);
-			req.length = MIN_FW_UPDATE_BASELINE_TRANS_SIZE;
-		} else if (req.length > fw_update_cfg.max_buff_size) {
-			LOG_WRN("Request length larger than maximum size, modify it from 0x%x to 0x%x",
-				req.length, fw_update_cfg.max_buff_size);
-			req.length = fw_update_cfg.max_buff_size;
-			expect_len = req.length;
-		} else {
-			expect_len = req.length;
+		uint32_t expect_len = fw_update_clamp_request(&req);
+		uint8_t *resp_buf = NULL;
+
+#ifdef ENABLE_PLDM_FW_UPDATE_PIPELINE
+		resp_buf = fw_prefetch_collect(&req, expect_len);
+		if (resp_buf) {
+			cur_buf ^= 1;
+			LOG_DBG("Request data at 0x%x, length 0x%x, served by prefetch", req.offset,
+				expect_len);
 		}
+#endif
 
-		uint8_t resp_buf[req.length + 1];
-		memset(resp_buf, 0, req.length + 1);
+		if (!resp_buf) {
+			resp_buf = data_buf[cur_buf];
+			memset(resp_buf, 0, req.length + 1);
 
-		uint16_t read_len =
-			pldm_fw_update_read(mctp_p, PLDM_FW_UPDATE_CMD_CODE_REQUEST_FIRMWARE_DATA,
-					    (uint8_t *)&req,
-					    sizeof(struct pldm_request_firmware_data_req), resp_buf,
-					    ARRAY_SIZE(resp_buf), ext_params);
+			uint16_t read_len = pldm_fw_update_read(
+				mctp_p, PLDM_FW_UPDATE_CMD_CODE_REQUEST_FIRMWARE_DATA,
+				(uint8_t *)&req, sizeof(struct pldm_request_firmware_data_req),
+				resp_buf, req.length + 1, ext_params);
 
-		if (read_len == 0) {
-			LOG_ERR("Request data failed at(0x%x, 0x%x), received empty response data",
-				req.offset, req.length);
-			cur_aux_state = STATE_AUX_FAILED;
-			goto exit;
-		}
+			if (read_len == 0) {
+				LOG_ERR("Request data failed at(0x%x, 0x%x), received empty response data",
+					req.offset, req.length);
+				cur_aux_state = STATE_AUX_FAILED;
+				goto exit;
+			}
 
-		LOG_DBG("Request data at 0x%x, length 0x%x, received data length 0x%x", req.offset,
-			req.length, read_len - 1);
+			LOG_DBG("Request data at 0x%x, length 0x%x, received data length 0x%x",
+				req.offset, req.length, read_len - 1);
 
-		if (last_offset != req.offset)
-			retry_count = 0;
+			if (last_offset != req.offset)
+				retry_count = 0;
 
-		last_offset = req.offset;
+			last_offset = req.offset;
 
-		if (read_len != (req.length + 1)) {
-			retry_count++;
-			if (retry_count > UPDATE_REQUEST_DATA_MAX_RETRY_COUNT) {
-				LOG_ERR("Request data failed at(0x%x, 0x%x), received unexpected data length 0x%x",
-					req.offset, req.length, read_len - 1);
-				cur_aux_state = STATE_AUX_FAILED;
-				goto exit;
-			}
+			if (read_len != (req.length + 1)) {
+				retry_count++;
+				if (retry_count > UPDATE_REQUEST_DATA_MAX_RETRY_COUNT) {
+					LOG_ERR("Request data failed at(0x%x, 0x%x), received unexpected data length 0x%x",
+						req.offset, req.length, read_len - 1);
+					cur_aux_state = STATE_AUX_FAILED;
+					goto exit;
+				}
 
-			LOG_WRN("Request data failed at(0x%x, 0x%x), received unexpected data length 0x%x, attempt %d and retry again",
-				req.offset, req.length, read_len - 1, retry_count);
-			continue;
-		}
+				LOG_WRN("Request data failed at(0x%x, 0x%x), received unexpected data length 0x%x, attempt %d and retry again",
+					req.offset, req.length, read_len - 1, retry_count);
+				continue;
+			}
 
-		if (resp_buf[0] != PLDM_SUCCESS) {
-			if (resp_buf[0] != PLDM_FW_UPDATE_CC_DATA_OUT_OF_RANGE) {
-				LOG_ERR("Request data failed at(0x%x, 0x%x), received unexpected cc 0x%x",
-					req.offset, req.length, resp_buf[0]);
-				cur_aux_state = STATE_AUX_FAILED;
-				goto exit;
+			if (resp_buf[0] != PLDM_SUCCESS) {
+				if (resp_buf[0] != PLDM_FW_UPDATE_CC_DATA_OUT_OF_RANGE) {
+					LOG_ERR("Request data failed at(0x%x, 0x%x), received unexpected cc 0x%x",
+						req.offset, req.length, resp_buf[0]);
+					cur_aux_state = STATE_AUX_FAILED;
+					goto exit;
+				}
 			}
 		}
 
 		update_param.data = resp_buf + 1;
 		update_param.data_len = expect_len;
 		update_param.data_ofs = req.offset;
+		recv_bytes += expect_len;
 
 		uint8_t percent = ((update_param.data_ofs + update_param.data_len) * 100) /
 				  fw_update_cfg.image_size;
 
 		static uint8_t previous_percent = 0;
 		if (previous_percent != percent)
-			LOG_INF("package loaded: %d%%", percent);
+			LOG_INF("package loaded: %d%%, %u KB/s", percent,
+				fw_update_kbps(recv_bytes, k_uptime_get() - start_ms));
 		previous_percent = percent;
 
+#ifdef ENABLE_PLDM_FW_UPDATE_PIPELINE
+		/* fetch the following chunk while update_func programs this one */
+		fw_prefetch_start(mctp_p, ext_params, req.offset + expect_len,
+				  data_buf[cur_buf ^ 1]);
+#endif
+
 		if (fw_info->update_func(&update_param)) {
 			LOG_ERR("Component %d update failed!", cur_update_comp_id);
+#ifdef ENABLE_PLDM_FW_UPDATE_PIPELINE
+			fw_prefetch_collect(NULL, 0);
+#endif
 			report_tranfer(mctp_p, ext_params, PLDM_FW_UPDATE_GENERIC_ERROR);
 			cur_aux_state = STATE_AUX_FAILED;
 			goto exit;
@@ -945,6 +1099,14 @@ void req_fw_update_handler(void *mctp_p, void *ext_params, void *arg)
 
 	} while (1);
 
+#ifdef ENABLE_PLDM_FW_UPDATE_PIPELINE
+	fw_prefetch_collect(NULL, 0);
+#endif
+
+	uint32_t elapsed_ms = (uint32_t)(k_uptime_get() - start_ms);
+	LOG_INF("Component %d received %u bytes in %u ms, %u KB/s", cur_update_comp_id, recv_bytes,
+		elapsed_ms, fw_update_kbps(recv_bytes, elapsed_ms));
+
 	LOG_INF("Component %d update success!", cur_update_comp_id);
 	cur_aux_state = STATE_AUX_SUCCESS;
 
@@ -991,6 +1153,10 @@ void req_fw_update_handler(void *mctp_p, void *ext_params, void *arg)
 	cur_aux_state = STATE_AUX_SUCCESS;
 
 exit:
+#ifdef ENABLE_PLDM_FW_UPDATE_PIPELINE
+	fw_prefetch_collect(NULL, 0);
+#endif
+
 #ifndef PLDM_UPDATE_POST_UPDATE_BEFORE_APPLY_COMPLETE
 	/* do post-update */
 	if (fw_info->pos_update_func) {
@@ -1000,6 +1166,10 @@ exit:
 	}
 #endif
 
+	for (uint8_t i = 0; i < PLDM_FW_UPDATE_BUF_NUM; i++) {
+		SAFE_FREE(data_buf[i]);
+	}
+
 	fw_update_cfg.image_size = 0;
 	if (fw_update_tid) {
 		fw_update_tid = NULL;
@@ -20,6 +20,7 @@
 #include <stdlib.h>
 #include <drivers/spi_nor.h>
 #include <drivers/flash.h>
+#include <sys/crc.h>
 #include "sensor.h"
 #include "plat_def.h"
 #ifdef ENABLE_PLDM_SENSOR
@@ -33,19 +34,29 @@
 #define PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX_DEFAULT
 #endif
 
-LOG_MODULE_DECLARE(pldm);
+#ifndef PLDM_MONITOR_EVENT_PACING_MS
+#define PLDM_MONITOR_EVENT_PACING_MS PLDM_MONITOR_EVENT_PACING_MS_DEFAULT
+#endif
 
-K_FIFO_DEFINE(send_event_pkt_fifo);
+LOG_MODULE_DECLARE(pldm);
 
 struct pldm_event_pkt {
-	void *fifo_reserved; /* 1st word reserved for use by fifo */
 	uint8_t event_class;
 	uint16_t id;
 	uint8_t ext_class;
 	uint8_t event_data[PLDM_MONITOR_EVENT_DATA_SIZE_MAX];
 	uint8_t event_data_length;
+	uint32_t queued_ms;
 };
 
+/* Static ring so events can be queued from any context, including ISRs */
+static struct pldm_event_pkt event_ring[PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX];
+static uint16_t event_ring_head;
+static uint16_t event_ring_count;
+static struct pldm_event_queue_stat event_queue_stat;
+static struct k_spinlock event_ring_lock;
+static bool event_pre_work_pending;
+
 static struct pldm_event_receiver_info {
 	mctp *mctp_inst_p;
 	mctp_ext_params ext_params;
@@ -58,7 +69,7 @@ struct pldm_state_effecter_info *state_effecter_table;
 
 uint16_t pldm_state_effecter_index = 0;
 
-static uint8_t get_sensor_data_size(pldm_sensor_readings_data_type_t data_type)
+uint8_t get_sensor_data_size(pldm_sensor_readings_data_type_t data_type)
 {
 	switch (data_type) {
 	case PLDM_SENSOR_DATA_SIZE_UINT8:
@@ -128,6 +139,46 @@ exit:
 	return val;
 }
 
+void pldm_sensor_status_to_pldm(uint8_t status, uint8_t *completion_code,
+				uint8_t *sensor_operational_state)
+{
+	CHECK_NULL_ARG(completion_code);
+	CHECK_NULL_ARG(sensor_operational_state);
+
+	switch (status) {
+	case SENSOR_READ_SUCCESS:
+	case SENSOR_READ_ACUR_SUCCESS:
+	case SENSOR_READ_4BYTE_ACUR_SUCCESS:
+		*completion_code = PLDM_SUCCESS;
+		*sensor_operational_state = PLDM_SENSOR_ENABLED;
+		break;
+	case SENSOR_NOT_ACCESSIBLE:
+	case SENSOR_INIT_STATUS:
+		*completion_code = PLDM_SUCCESS;
+		*sensor_operational_state = PLDM_SENSOR_INITIALIZING;
+		break;
+	case SENSOR_POLLING_DISABLE:
+		*completion_code = PLDM_SUCCESS;
+		*sensor_operational_state = PLDM_SENSOR_STATUSUNKOWN;
+		break;
+	case SENSOR_NOT_FOUND:
+		// request sensor number not found
+		*completion_code = PLDM_PLATFORM_INVALID_SENSOR_ID;
+		*sensor_operational_state = PLDM_SENSOR_STATUSUNKOWN;
+		break;
+	case SENSOR_UNAVAILABLE:
+		*completion_code = PLDM_SUCCESS;
+		*sensor_operational_state = PLDM_SENSOR_UNAVAILABLE;
+		break;
+	case SENSOR_FAIL_TO_ACCESS:
+	case SENSOR_UNSPECIFIED_ERROR:
+	default:
+		*completion_code = PLDM_SUCCESS;
+		*sensor_operational_state = PLDM_SENSOR_FAILED;
+		break;
+	}
+}
+
 uint8_t pldm_get_sensor_reading(void *mctp_inst, uint8_t *buf, uint16_t len, uint8_t instance_id,
 				uint8_t *resp, uint16_t *resp_len, void *ext_params)
 {
@@ -146,7 +197,11 @@ uint8_t pldm_get_sensor_reading(void *mctp_inst, uint8_t *buf, uint16_t len, uin
 	struct pldm_get_sensor_reading_req *req_p = (struct pldm_get_sensor_reading_req *)buf;
 	struct pldm_get_sensor_reading_resp *res_p = (struct pldm_get_sensor_reading_resp *)resp;
 	uint8_t sensor_number = (uint8_t)req_p->sensor_id;
+#ifdef ENABLE_PLDM_SENSOR
+	const pldm_sensor_info *sensor_info = NULL;
+#else
 	PDR_numeric_sensor sensor_pdr;
+#endif
 
 	if (len != PLDM_GET_SENSOR_READING_REQ_BYTES) {
 		res_p->completion_code = PLDM_ERROR_INVALID_LENGTH;
@@ -174,47 +229,27 @@ uint8_t pldm_get_sensor_reading(void *mctp_inst, uint8_t *buf, uint16_t len, uin
 	status = get_sensor_reading(sensor_config, sensor_config_count, sensor_number, &reading,
 				    GET_FROM_CACHE);
 
-	switch (status) {
-	case SENSOR_READ_SUCCESS:
-	case SENSOR_READ_ACUR_SUCCESS:
-	case SENSOR_READ_4BYTE_ACUR_SUCCESS:
-		res_p->completion_code = PLDM_SUCCESS;
-		res_p->sensor_operational_state = PLDM_SENSOR_ENABLED;
-		break;
-	case SENSOR_NOT_ACCESSIBLE:
-	case SENSOR_INIT_STATUS:
-		res_p->completion_code = PLDM_SUCCESS;
-		res_p->sensor_operational_state = PLDM_SENSOR_INITIALIZING;
-		break;
-	case SENSOR_POLLING_DISABLE:
-		res_p->completion_code = PLDM_SUCCESS;
-		res_p->sensor_operational_state = PLDM_SENSOR_STATUSUNKOWN;
-		break;
-	case SENSOR_NOT_FOUND:
-		// request sensor number not found
-		res_p->completion_code = PLDM_PLATFORM_INVALID_SENSOR_ID;
-		res_p->sensor_operational_state = PLDM_SENSOR_STATUSUNKOWN;
-		break;
-	case SENSOR_UNAVAILABLE:
-		res_p->completion_code = PLDM_SUCCESS;
-		res_p->sensor_operational_state = PLDM_SENSOR_UNAVAILABLE;
-		break;
-	case SENSOR_FAIL_TO_ACCESS:
-	case SENSOR_UNSPECIFIED_ERROR:
-	default:
-		res_p->completion_code = PLDM_SUCCESS;
-		res_p->sensor_operational_state = PLDM_SENSOR_FAILED;
-		break;
-	}
+	pldm_sensor_status_to_pldm(status, &res_p->completion_code,
+				   &res_p->sensor_operational_state);
 #endif
 
 ret:
+#ifdef ENABLE_PLDM_SENSOR
+	sensor_info = pldm_sensor_find_info_via_sensor_id(sensor_number);
+	if (sensor_info == NULL) {
+		/* Only support 4-bytes unsinged sensor data */
+		res_p->sensor_data_size = PLDM_SENSOR_DATA_SIZE_UINT32;
+	} else {
+		res_p->sensor_data_size = sensor_info->pdr_numeric_sensor.sensor_data_size;
+	}
+#else
 	if (get_pdr_with_sensor_id(sensor_number, &sensor_pdr) != 0) {
 		/* Only support 4-bytes unsinged sensor data */
 		res_p->sensor_data_size = PLDM_SENSOR_DATA_SIZE_UINT32;
 	} else {
 		res_p->sensor_data_size = sensor_pdr.sensor_data_size;
 	}
+#endif
 
 	res_p->sensor_event_message_enable = PLDM_EVENTS_DISABLED;
 	res_p->previous_state =
@@ -224,6 +259,17 @@ ret:
 	res_p->event_state =
 		(res_p->completion_code == PLDM_SUCCESS) ? PLDM_SENSOR_NORMAL : PLDM_SENSOR_UNKNOWN;
 
+#if defined(ENABLE_PLDM_SENSOR) && defined(ENABLE_PLDM_SENSOR_THRESHOLD_EVENT)
+	uint8_t present_state, previous_state;
+	if ((res_p->completion_code == PLDM_SUCCESS) &&
+	    pldm_sensor_get_threshold_state(sensor_number, &present_state, &previous_state)) {
+		res_p->sensor_event_message_enable = PLDM_EVENTS_ENABLED;
+		res_p->previous_state = previous_state;
+		res_p->present_state = present_state;
+		res_p->event_state = present_state;
+	}
+#endif
+
 	if ((res_p->completion_code != PLDM_SUCCESS) ||
 	    (res_p->sensor_operational_state != PLDM_SENSOR_ENABLED))
 		reading = -1;
@@ -403,30 +449,151 @@ __weak void plat_send_event_pre_work()
 	return;
 }
 
+/* Events of the same sensor/effecter, and state sensor offset, may merge while queued */
+static bool pldm_event_same_source(const struct pldm_event_pkt *pkt, uint8_t event_class,
+				   uint16_t id, uint8_t ext_class, const uint8_t *event_data,
+				   uint8_t event_data_length)
+{
+	if ((pkt->event_class != event_class) || (pkt->id != id) || (pkt->ext_class != ext_class)) {
+		return false;
+	}
+
+	if ((event_class == PLDM_SENSOR_EVENT) && (ext_class == PLDM_STATE_SENSOR_STATE)) {
+		return (pkt->event_data_length != 0) && (event_data_length != 0) &&
+		       (pkt->event_data[0] == event_data[0]);
+	}
+
+	return true;
+}
+
+static int pldm_event_prev_state_ofs(uint8_t event_class, uint8_t ext_class)
+{
+	if (event_class == PLDM_EFFECTER_EVENT) {
+		return offsetof(struct pldm_effeter_event_op_state, previous_op_state);
+	}
+
+	switch (ext_class) {
+	case PLDM_SENSOR_OP_STATE:
+		return offsetof(struct pldm_sensor_event_sensor_op_state, previous_op_state);
+	case PLDM_STATE_SENSOR_STATE:
+		return offsetof(struct pldm_sensor_event_state_sensor_state, previous_event_state);
+	case PLDM_NUMERIC_SENSOR_STATE:
+		return offsetof(struct pldm_sensor_event_numeric_sensor_state,
+				previous_event_state);
+	default:
+		return -1;
+	}
+}
+
+/*
+ * Replace the queued event with the newer one only when both report the same transition, e.g. a
+ * numeric sensor refreshing its reading. A different transition is queued on its own, merging it
+ * could turn NORMAL->ALERT->NORMAL into NORMAL->NORMAL and lose the fault.
+ */
+static bool pldm_event_coalesce(struct pldm_event_pkt *pkt, const uint8_t *event_data,
+				uint8_t event_data_length)
+{
+	if ((pkt->event_data_length == event_data_length) &&
+	    (memcmp(pkt->event_data, event_data, event_data_length) == 0)) {
+		return true;
+	}
+
+	int ofs = pldm_event_prev_state_ofs(pkt->event_class, pkt->ext_class);
+	if ((ofs < 1) || (ofs >= pkt->event_data_length) || (ofs >= event_data_length)) {
+		return false;
+	}
+
+	// Present state sits right before the previous state in every supported format
+	if ((pkt->event_data[ofs - 1] != event_data[ofs - 1]) ||
+	    (pkt->event_data[ofs] != event_data[ofs])) {
+		return false;
+	}
+
+	memcpy(pkt->event_data, event_data, event_data_length);
+	pkt->event_data_length = event_data_length;
+	return true;
+}
+
+static bool pldm_event_dequeue(struct pldm_event_pkt *pkt)
+{
+	bool ret = false;
+
+	k_spinlock_key_t key = k_spin_lock(&event_ring_lock);
+	if (event_ring_count) {
+		memcpy(pkt, &event_ring[event_ring_head], sizeof(*pkt));
+		event_ring_head = (event_ring_head + 1) % PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX;
+		event_ring_count--;
+		ret = true;
+	}
+	k_spin_unlock(&event_ring_lock, key);
+
+	return ret;
+}
+
+static uint8_t pldm_send_event_to_receiver(const struct pldm_event_pkt *pkt)
+{
+	struct pldm_event_receiver_info *event_receiver_info_p = &event_receiver_info;
+
+	switch (pkt->event_class) {
+	case PLDM_SENSOR_EVENT:
+		return pldm_send_sensor_event_message(event_receiver_info_p->mctp_inst_p,
+						      event_receiver_info_p->ext_params, pkt->id,
+						      pkt->ext_class, pkt->event_data,
+						      pkt->event_data_length);
+	case PLDM_EFFECTER_EVENT:
+		return pldm_send_effecter_event_message(event_receiver_info_p->mctp_inst_p,
+							event_receiver_info_p->ext_params, pkt->id,
+							pkt->ext_class, pkt->event_data,
+							pkt->event_data_length);
+	default:
+		LOG_ERR("Unsupported event class, (%d)", pkt->event_class);
+		return PLDM_ERROR;
+	}
+}
+
+/* Sends one event per run and requeues itself, so a burst drains without holding the workqueue */
 static void process_event_message_queue(struct k_work *work)
 {
 	CHECK_NULL_ARG(work);
-	struct pldm_event_pkt *pkt;
+	struct k_work_delayable *dwork = k_work_delayable_from_work(work);
+	struct pldm_event_pkt pkt;
 
-	plat_send_event_pre_work();
+	if (event_pre_work_pending) {
+		event_pre_work_pending = false;
+		plat_send_event_pre_work();
+	}
 
-	if ((pkt = k_fifo_get(&send_event_pkt_fifo, K_NO_WAIT)) != NULL) {
-		if (pldm_send_platform_event(pkt->event_class, pkt->id, pkt->ext_class,
-					     pkt->event_data,
-					     pkt->event_data_length) != PLDM_SUCCESS) {
-			LOG_ERR("Send event failed, event_class (0x%x) id (0x%x) ext_class (%x)",
-				pkt->event_class, pkt->id, pkt->ext_class);
-			LOG_HEXDUMP_ERR(pkt->event_data, pkt->event_data_length, "Event data:");
-		} else {
-			LOG_DBG("Send event succeeded, event_class (0x%x) id (0x%x) ext_class (%x)",
-				pkt->event_class, pkt->id, pkt->ext_class);
-			LOG_HEXDUMP_DBG(pkt->event_data, pkt->event_data_length, "Event data:");
-		}
+	if (pldm_event_dequeue(&pkt) == false) {
+		LOG_DBG("The event packet queue is empty, send the event work complete.");
+		return;
+	}
+
+	uint8_t ret = pldm_send_event_to_receiver(&pkt);
+	uint32_t latency_ms = k_uptime_get_32() - pkt.queued_ms;
+
+	if (ret != PLDM_SUCCESS) {
+		LOG_ERR("Send event failed, event_class (0x%x) id (0x%x) ext_class (%x)",
+			pkt.event_class, pkt.id, pkt.ext_class);
+		LOG_HEXDUMP_ERR(pkt.event_data, pkt.event_data_length, "Event data:");
+	} else {
+		LOG_DBG("Send event succeeded, event_class (0x%x) id (0x%x) ext_class (%x)",
+			pkt.event_class, pkt.id, pkt.ext_class);
+		LOG_HEXDUMP_DBG(pkt.event_data, pkt.event_data_length, "Event data:");
+	}
 
-		SAFE_FREE(pkt);
-		k_work_schedule((struct k_work_delayable *)work, K_SECONDS(1));
+	k_spinlock_key_t key = k_spin_lock(&event_ring_lock);
+	if (ret != PLDM_SUCCESS) {
+		event_queue_stat.failed++;
 	} else {
-		LOG_INF("The event packet queue is empty, send the event work complete.");
+		event_queue_stat.sent++;
+		event_queue_stat.latency_last_ms = latency_ms;
+		event_queue_stat.latency_max_ms = MAX(event_queue_stat.latency_max_ms, latency_ms);
+	}
+	bool pending = (event_ring_count != 0);
+	k_spin_unlock(&event_ring_lock, key);
+
+	if (pending) {
+		k_work_schedule(dwork, K_MSEC(PLDM_MONITOR_EVENT_PACING_MS));
 	}
 }
 
@@ -437,35 +604,61 @@ static uint8_t send_event_to_queue(uint8_t event_class, uint16_t id, uint8_t ext
 {
 	CHECK_NULL_ARG_WITH_RETURN(event_data, PLDM_ERROR);
 
-	static uint8_t count = 0;
-	struct pldm_event_pkt *pkt;
-
 	if (event_data_length > PLDM_MONITOR_EVENT_DATA_SIZE_MAX) {
 		LOG_ERR("Invalid event data length, (%d)", event_data_length);
 		return PLDM_ERROR_INVALID_LENGTH;
 	}
 
-	if (count > PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX - 1) {
-		LOG_ERR("Number of messages in the queue has reached maximum");
-		return PLDM_ERROR;
-	}
+	uint8_t ret = PLDM_SUCCESS;
+	k_spinlock_key_t key = k_spin_lock(&event_ring_lock);
+
+	/* Only the newest queued event of the same source may absorb this one, keeps the order */
+	for (uint16_t i = event_ring_count; i > 0; i--) {
+		uint16_t index = (event_ring_head + i - 1) % PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX;
+		struct pldm_event_pkt *pkt = &event_ring[index];
+		if (pldm_event_same_source(pkt, event_class, id, ext_class, event_data,
+					   event_data_length) != true) {
+			continue;
+		}
 
-	pkt = (struct pldm_event_pkt *)malloc(sizeof(struct pldm_event_pkt));
+		if (pldm_event_coalesce(pkt, event_data, event_data_length) == true) {
+			event_queue_stat.coalesced++;
+			goto unlock;
+		}
+		break;
+	}
 
-	if (!pkt) {
-		LOG_ERR("Event packet memory allocate failed");
-		return PLDM_ERROR;
+	if (event_ring_count >= PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX) {
+		event_queue_stat.dropped++;
+		ret = PLDM_ERROR;
+		goto unlock;
 	}
 
+	uint16_t tail = (event_ring_head + event_ring_count) % PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX;
+	struct pldm_event_pkt *pkt = &event_ring[tail];
 	pkt->event_class = event_class;
 	pkt->id = id;
 	pkt->ext_class = ext_class;
 	pkt->event_data_length = event_data_length;
-
 	memcpy(pkt->event_data, event_data, event_data_length);
+	pkt->queued_ms = k_uptime_get_32();
 
-	k_fifo_put(&send_event_pkt_fifo, pkt);
-	count++;
+	event_ring_count++;
+	event_queue_stat.queued++;
+	event_queue_stat.depth_max = MAX(event_queue_stat.depth_max, event_ring_count);
+
+unlock:
+	k_spin_unlock(&event_ring_lock, key);
+
+	if (ret != PLDM_SUCCESS) {
+		LOG_ERR("Number of messages in the queue has reached maximum");
+		return ret;
+	}
+
+	/* Until SetEventReceiver arrives events just wait in the queue */
+	if (event_receiver_info.mctp_inst_p) {
+		k_work_schedule(&send_event_pkt_work, K_NO_WAIT);
+	}
 
 	return PLDM_SUCCESS;
 }
@@ -475,26 +668,24 @@ uint8_t pldm_send_platform_event(uint8_t event_class, uint16_t id, uint8_t ext_c
 {
 	CHECK_NULL_ARG_WITH_RETURN(event_data, PLDM_ERROR);
 
-	struct pldm_event_receiver_info *event_receiver_info_p = &event_receiver_info;
-
-	if (!event_receiver_info_p->mctp_inst_p) {
-		return send_event_to_queue(event_class, id, ext_class, event_data,
-					   event_data_length);
-	}
-
-	switch (event_class) {
-	case PLDM_SENSOR_EVENT:
-		return pldm_send_sensor_event_message(event_receiver_info_p->mctp_inst_p,
-						      event_receiver_info_p->ext_params, id,
-						      ext_class, event_data, event_data_length);
-	case PLDM_EFFECTER_EVENT:
-		return pldm_send_effecter_event_message(event_receiver_info_p->mctp_inst_p,
-							event_receiver_info_p->ext_params, id,
-							ext_class, event_data, event_data_length);
-	default:
+	if ((event_class != PLDM_SENSOR_EVENT) && (event_class != PLDM_EFFECTER_EVENT)) {
 		LOG_ERR("Unsupported event class, (%d)", event_class);
 		return PLDM_ERROR;
 	}
+
+	return send_event_to_queue(event_class, id, ext_class, event_data, event_data_length);
+}
+
+bool pldm_get_event_queue_stat(struct pldm_event_queue_stat *stat)
+{
+	CHECK_NULL_ARG_WITH_RETURN(stat, false);
+
+	k_spinlock_key_t key = k_spin_lock(&event_ring_lock);
+	memcpy(stat, &event_queue_stat, sizeof(*stat));
+	stat->depth = event_ring_count;
+	k_spin_unlock(&event_ring_lock, key);
+
+	return true;
 }
 
 __weak void pldm_set_event_receiver_received()
@@ -548,6 +739,8 @@ uint8_t pldm_set_event_receiver(void *mctp_inst, uint8_t *buf, uint16_t len, uin
 
 	*completion_code_p = PLDM_SUCCESS;
 
+	/* Give the receiver a moment after SetEventReceiver, then drain everything queued so far */
+	event_pre_work_pending = true;
 	k_work_schedule(&send_event_pkt_work, K_MSEC(1000));
 
 	pldm_set_event_receiver_received();
@@ -923,9 +1116,12 @@ uint8_t pldm_get_pdr_info(void *mctp_inst, uint8_t *buf, uint16_t len, uint8_t i
 	}
 
 	res_p->repository_state = pdr_info->repository_state;
+	memcpy(res_p->update_time, pdr_info->update_time, sizeof(res_p->update_time));
+	memcpy(res_p->oem_update_time, pdr_info->oem_update_time, sizeof(res_p->oem_update_time));
 	res_p->record_count = pdr_info->record_count;
 	res_p->repository_size = pdr_info->repository_size;
 	res_p->largest_record_size = pdr_info->largest_record_size;
+	res_p->data_transfer_handle_timeout = pdr_info->data_transfer_handle_timeout;
 	*resp_len = sizeof(struct pldm_get_pdr_info_resp);
 	res_p->completion_code = PLDM_SUCCESS;
 
@@ -941,16 +1137,68 @@ uint8_t pldm_get_pdr(void *mctp_inst, uint8_t *buf, uint16_t len, uint8_t instan
 	CHECK_NULL_ARG_WITH_RETURN(resp_len, PLDM_ERROR);
 	CHECK_NULL_ARG_WITH_RETURN(ext_params, PLDM_ERROR);
 
-	int response_count = 0;
 	uint32_t record_count = get_record_count();
 	struct pldm_get_pdr_req *req_p = (struct pldm_get_pdr_req *)buf;
 	struct pldm_get_pdr_resp *res_p = (struct pldm_get_pdr_resp *)resp;
 
-	response_count =
-		get_pdr_table_via_record_handle(&res_p->record_data[0], req_p->record_handle);
-	if (response_count <= 0) {
-		LOG_ERR("Failed to get PDR for record handle: %x\n", req_p->record_handle);
-		return PLDM_ERROR;
+	*resp_len = 1;
+
+	if (len != sizeof(struct pldm_get_pdr_req)) {
+		res_p->completion_code = PLDM_ERROR_INVALID_LENGTH;
+		return PLDM_SUCCESS;
+	}
+
+	uint16_t record_len = 0;
+	const uint8_t *record = get_pdr_record_via_record_handle(req_p->record_handle, &record_len);
+	if (record == NULL) {
+		LOG_ERR("Failed to get PDR for record handle: %x", req_p->record_handle);
+		res_p->completion_code = PLDM_PLATFORM_INVALID_RECORD_HANDLE;
+		return PLDM_SUCCESS;
+	}
+
+	/* The data transfer handle is the byte offset of the next part within the record */
+	uint32_t offset = 0;
+	if (req_p->transfer_operation_flag == PLDM_GET_PDR_NEXT_PART) {
+		const PDR_common_header *header = (const PDR_common_header *)record;
+
+		if ((req_p->data_transfer_handle == 0) ||
+		    (req_p->data_transfer_handle >= record_len)) {
+			res_p->completion_code = PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE;
+			return PLDM_SUCCESS;
+		}
+		if (req_p->record_change_number != header->record_change_number) {
+			res_p->completion_code = PLDM_PLATFORM_INVALID_RECORD_CHANGE_NUMBER;
+			return PLDM_SUCCESS;
+		}
+		offset = req_p->data_transfer_handle;
+	} else if (req_p->transfer_operation_flag != PLDM_GET_PDR_FIRST_PART) {
+		res_p->completion_code = PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG;
+		return PLDM_SUCCESS;
+	}
+
+	if (req_p->request_count == 0) {
+		res_p->completion_code = PLDM_ERROR_INVALID_DATA;
+		return PLDM_SUCCESS;
+	}
+
+	uint16_t response_count = MIN(req_p->request_count, PLDM_GET_PDR_MAX_RESPONSE_COUNT);
+	response_count = MIN(response_count, record_len - offset);
+	bool is_last_part = ((offset + response_count) == record_len);
+
+	memcpy(res_p->record_data, record + offset, response_count);
+	*resp_len = sizeof(struct pldm_get_pdr_resp) + response_count;
+
+	if (offset == 0) {
+		res_p->transfer_flag =
+			is_last_part ? PLDM_TRANSFER_FLAG_START_AND_END : PLDM_TRANSFER_FLAG_START;
+	} else {
+		res_p->transfer_flag = is_last_part ? PLDM_TRANSFER_FLAG_END :
+						      PLDM_TRANSFER_FLAG_MIDDLE;
+	}
+
+	if (res_p->transfer_flag == PLDM_TRANSFER_FLAG_END) {
+		res_p->record_data[response_count] = crc8_ccitt(0, record, record_len);
+		*resp_len += 1;
 	}
 
 	if (req_p->record_handle + 1 >= record_count) {
@@ -959,13 +1207,32 @@ uint8_t pldm_get_pdr(void *mctp_inst, uint8_t *buf, uint16_t len, uint8_t instan
 		res_p->next_record_handle = req_p->record_handle + 1;
 	}
 
-	res_p->transfer_flag = PLDM_TRANSFER_FLAG_START_AND_END;
+	res_p->next_data_transfer_handle = is_last_part ? 0 : (offset + response_count);
 	res_p->response_count = response_count;
-	*resp_len = sizeof(struct pldm_get_pdr_resp);
 	res_p->completion_code = PLDM_SUCCESS;
 	return PLDM_SUCCESS;
 }
 
+uint8_t pldm_get_pdr_repository_signature(void *mctp_inst, uint8_t *buf, uint16_t len,
+					  uint8_t instance_id, uint8_t *resp, uint16_t *resp_len,
+					  void *ext_params)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(buf, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(resp, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(resp_len, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(ext_params, PLDM_ERROR);
+
+	struct pldm_get_pdr_repository_signature_resp *res_p =
+		(struct pldm_get_pdr_repository_signature_resp *)resp;
+
+	res_p->repository_signature = get_pdr_repository_signature();
+	res_p->completion_code = PLDM_SUCCESS;
+	*resp_len = sizeof(struct pldm_get_pdr_repository_signature_resp);
+
+	return PLDM_SUCCESS;
+}
+
 static pldm_cmd_handler pldm_monitor_cmd_tbl[] = {
 	{ PLDM_MONITOR_CMD_CODE_GET_SENSOR_READING, pldm_get_sensor_reading },
 	{ PLDM_MONITOR_CMD_CODE_SET_EVENT_RECEIVER, pldm_set_event_receiver },
@@ -974,6 +1241,7 @@ static pldm_cmd_handler pldm_monitor_cmd_tbl[] = {
 	{ PLDM_MONITOR_CMD_CODE_GET_STATE_EFFECTER_STATES, pldm_get_state_effecter_states },
 	{ PLDM_MONITOR_CMD_CODE_GET_PDR_INFO, pldm_get_pdr_info },
 	{ PLDM_MONITOR_CMD_CODE_GET_PDR, pldm_get_pdr },
+	{ PLDM_MONITOR_CMD_CODE_GET_PDR_REPOSITORY_SIGNATURE, pldm_get_pdr_repository_signature },
 };
 
 uint8_t pldm_monitor_handler_query(uint8_t code, void **ret_fn)
@@ -35,6 +35,7 @@ typedef enum pldm_platform_monitor_commands {
 	PLDM_MONITOR_CMD_CODE_GET_STATE_EFFECTER_STATES = 0x3A,
 	PLDM_MONITOR_CMD_CODE_GET_PDR_INFO = 0x50,
 	PLDM_MONITOR_CMD_CODE_GET_PDR = 0x51,
+	PLDM_MONITOR_CMD_CODE_GET_PDR_REPOSITORY_SIGNATURE = 0x53,
 } pldm_platform_monitor_commands_t;
 
 /* define size of request */
@@ -47,7 +48,9 @@ typedef enum pldm_platform_monitor_commands {
 /* The maximum event data size of event type currently support, ipmi event 16 bytes */
 #define PLDM_MONITOR_EVENT_DATA_SIZE_MAX 16
 /* The default maximum event message number in the queue */
-#define PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX_DEFAULT 10
+#define PLDM_MONITOR_EVENT_QUEUE_MSG_NUM_MAX_DEFAULT 32
+/* The default gap between two queued event messages, 0 sends them back-to-back */
+#define PLDM_MONITOR_EVENT_PACING_MS_DEFAULT 0
 #define PLDM_MONITOR_SENSOR_SUPPORT_MAX 0xFF
 #define PLDM_MONITOR_SENSOR_EVENT_SENSOR_OP_STATE_DATA_LENGTH 2
 #define PLDM_MONITOR_SENSOR_EVENT_STATE_SENSOR_STATE_DATA_LENGTH 3
@@ -181,6 +184,13 @@ enum pldm_platform_completion_codes {
 	PLDM_PLATFORM_INVALID_STATE_VALUE = 0x81,
 	PLDM_PLATFORM_UNSUPPORTED_EFFECTERSTATE = 0x82,
 
+	/* GetPDR */
+	PLDM_PLATFORM_INVALID_DATA_TRANSFER_HANDLE = 0x80,
+	PLDM_PLATFORM_INVALID_TRANSFER_OPERATION_FLAG = 0x81,
+	PLDM_PLATFORM_INVALID_RECORD_HANDLE = 0x82,
+	PLDM_PLATFORM_INVALID_RECORD_CHANGE_NUMBER = 0x83,
+	PLDM_PLATFORM_TRANSFER_TIMEOUT = 0x84,
+	PLDM_PLATFORM_REPOSITORY_UPDATE_IN_PROGRESS = 0x85,
 };
 
 enum pldm_oem_platform_completion_codes {
@@ -395,6 +405,11 @@ enum pldm_get_pdr_transfer_flag {
 	PLDM_TRANSFER_FLAG_START_AND_END = 0x05,
 };
 
+enum pldm_get_pdr_transfer_operation_flag {
+	PLDM_GET_PDR_NEXT_PART = 0x00,
+	PLDM_GET_PDR_FIRST_PART = 0x01,
+};
+
 struct pldm_get_pdr_req {
 	uint32_t record_handle;
 	uint32_t data_transfer_handle;
@@ -409,10 +424,14 @@ struct pldm_get_pdr_resp {
 	uint32_t next_data_transfer_handle;
 	uint8_t transfer_flag;
 	uint16_t response_count;
-	uint8_t record_data[NUMERIC_PDR_SIZE];
-	//uint8_t transferCRC;
+	/* transferCRC of the whole record follows the last part */
+	uint8_t record_data[];
 } __attribute__((packed));
 
+/* Largest part of a record that fits a response together with its transferCRC */
+#define PLDM_GET_PDR_MAX_RESPONSE_COUNT                                                            \
+	(PLDM_MAX_DATA_SIZE - sizeof(pldm_hdr) - sizeof(struct pldm_get_pdr_resp) - 1)
+
 struct pldm_get_pdr_info_resp {
 	uint8_t completion_code;
 	uint8_t repository_state;
@@ -424,6 +443,11 @@ struct pldm_get_pdr_info_resp {
 	uint8_t data_transfer_handle_timeout;
 } __attribute__((packed));
 
+struct pldm_get_pdr_repository_signature_resp {
+	uint8_t completion_code;
+	uint32_t repository_signature;
+} __attribute__((packed));
+
 struct pldm_state_effecter_info {
 	uint16_t entity_type;
 	uint16_t effecter_id;
@@ -437,9 +461,24 @@ enum pldm_effecter_id_low_byte {
 	PLDM_EFFECTER_ID_ADDSEL_LOW_BYTE = 0x05,
 };
 
+struct pldm_event_queue_stat {
+	uint32_t queued;
+	uint32_t sent;
+	uint32_t failed;
+	uint32_t dropped; /* queue full */
+	uint32_t coalesced; /* merged into a queued event with the same source and transition */
+	uint16_t depth;
+	uint16_t depth_max;
+	uint32_t latency_last_ms; /* from queued to accepted by the event receiver */
+	uint32_t latency_max_ms;
+};
+
 extern struct pldm_state_effecter_info *state_effecter_table;
 
 uint8_t pldm_monitor_handler_query(uint8_t code, void **ret_fn);
+uint8_t get_sensor_data_size(pldm_sensor_readings_data_type_t data_type);
+void pldm_sensor_status_to_pldm(uint8_t status, uint8_t *completion_code,
+				uint8_t *sensor_operational_state);
 
 uint8_t pldm_platform_event_message_req(void *mctp_inst, mctp_ext_params ext_params,
 					uint8_t event_class, const uint8_t *event_data,
@@ -451,6 +490,7 @@ uint16_t pldm_platform_monitor_read(void *mctp_inst, mctp_ext_params ext_params,
 
 uint8_t pldm_send_platform_event(uint8_t event_class, uint16_t id, uint8_t ext_class,
 				 const uint8_t *event_data, uint8_t event_data_length);
+bool pldm_get_event_queue_stat(struct pldm_event_queue_stat *stat);
 
 void set_effecter_state_gpio_handler(const uint8_t *buf, uint16_t len, uint8_t *resp,
 				     uint16_t *resp_len, uint8_t gpio_pin);
@@ -19,6 +19,11 @@
 #include "ipmb.h"
 #include "libutil.h"
 #include "util_sys.h"
+#include "sensor.h"
+#include "plat_def.h"
+#ifdef ENABLE_PLDM_SENSOR
+#include "pldm_sensor.h"
+#endif
 #include <logging/log.h>
 #include <stdlib.h>
 #include <string.h>
@@ -297,6 +302,92 @@ uint8_t send_event_log_to_bmc(struct pldm_addsel_data sel_msg)
 #endif
 #endif
 
+static uint8_t bulk_sensor_reading_cmd(void *mctp_inst, uint8_t *buf, uint16_t len,
+				       uint8_t instance_id, uint8_t *resp, uint16_t *resp_len,
+				       void *ext_params)
+{
+	CHECK_NULL_ARG_WITH_RETURN(mctp_inst, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(buf, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(resp, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(resp_len, PLDM_ERROR);
+	CHECK_NULL_ARG_WITH_RETURN(ext_params, PLDM_ERROR);
+
+	const struct _bulk_sensor_reading_req *req_p =
+		(const struct _bulk_sensor_reading_req *)buf;
+	struct _bulk_sensor_reading_resp *resp_p = (struct _bulk_sensor_reading_resp *)resp;
+
+	*resp_len = 1;
+
+	if (len != sizeof(struct _bulk_sensor_reading_req)) {
+		resp_p->completion_code = PLDM_ERROR_INVALID_LENGTH;
+		return PLDM_SUCCESS;
+	}
+
+	if (check_iana(req_p->iana) == PLDM_ERROR) {
+		resp_p->completion_code = PLDM_ERROR_INVALID_DATA;
+		return PLDM_SUCCESS;
+	}
+
+	uint16_t start_id = req_p->start_sensor_id;
+	uint16_t end_id = req_p->end_sensor_id;
+	if ((start_id > end_id) || (end_id == 0xFFFF)) {
+		resp_p->completion_code = PLDM_ERROR_INVALID_DATA;
+		return PLDM_SUCCESS;
+	}
+
+#ifndef ENABLE_PLDM_SENSOR
+	/* sensor_config only holds one byte sensor numbers */
+	end_id = MIN(end_id, SENSOR_NUM_MAX - 1);
+#endif
+
+	uint16_t max_count = (PLDM_MAX_DATA_SIZE - sizeof(pldm_hdr) -
+			      sizeof(struct _bulk_sensor_reading_resp)) /
+			     sizeof(struct _bulk_sensor_reading_entry);
+	uint16_t count = 0;
+	uint32_t id;
+	for (id = start_id; id <= end_id; id++) {
+		struct _bulk_sensor_reading_entry entry = { .sensor_id = id };
+		int reading = 0;
+
+#ifdef ENABLE_PLDM_SENSOR
+		entry.completion_code = pldm_sensor_get_reading_from_cache(
+			id, &reading, &entry.sensor_operational_state);
+		if (entry.completion_code == PLDM_PLATFORM_INVALID_SENSOR_ID) {
+			continue;
+		}
+#else
+		/* Skip unconfigured ids without walking the whole table */
+		if (find_sensor_cfg_via_sensor_num(sensor_config, sensor_config_count, id) ==
+		    NULL) {
+			continue;
+		}
+		uint8_t status = get_sensor_reading(sensor_config, sensor_config_count, id,
+						    &reading, GET_FROM_CACHE);
+		pldm_sensor_status_to_pldm(status, &entry.completion_code,
+					   &entry.sensor_operational_state);
+#endif
+
+		if ((entry.completion_code != PLDM_SUCCESS) ||
+		    (entry.sensor_operational_state != PLDM_SENSOR_ENABLED)) {
+			reading = -1;
+		}
+		entry.present_reading = reading;
+
+		if (count >= max_count) {
+			break;
+		}
+		memcpy(&resp_p->entry[count++], &entry, sizeof(entry));
+	}
+
+	set_iana(resp_p->iana, sizeof(resp_p->iana));
+	resp_p->completion_code = PLDM_SUCCESS;
+	resp_p->next_sensor_id = (id <= end_id) ? id : 0xFFFF;
+	resp_p->sensor_count = count;
+	*resp_len = sizeof(struct _bulk_sensor_reading_resp) +
+		    count * sizeof(struct _bulk_sensor_reading_entry);
+	return PLDM_SUCCESS;
+}
+
 static pldm_cmd_handler pldm_oem_cmd_tbl[] = {
 	{ PLDM_OEM_CMD_ECHO, cmd_echo },
 	{ PLDM_OEM_IPMI_BRIDGE, ipmi_cmd },
@@ -307,6 +398,7 @@ static pldm_cmd_handler pldm_oem_cmd_tbl[] = {
 	{ PLDM_OEM_FORCE_UPDATE_SETTING_CMD, force_update_flag_set_cmd },
 	{ PLDM_OEM_FORCE_UPDATE_GETTING_CMD, force_update_flag_get_cmd },
 	{ PLDM_OEM_READ_FLASH_DATA_CMD, read_flash_data_cmd },
+	{ PLDM_OEM_BULK_SENSOR_READING_CMD, bulk_sensor_reading_cmd },
 };
 
 uint8_t pldm_oem_handler_query(uint8_t code, void **ret_fn)
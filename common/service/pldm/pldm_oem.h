@@ -40,6 +40,7 @@ extern "C" {
 #define PLDM_OEM_FORCE_UPDATE_SETTING_CMD 0x06
 #define PLDM_OEM_FORCE_UPDATE_GETTING_CMD 0x07
 #define PLDM_OEM_READ_FLASH_DATA_CMD 0x08
+#define PLDM_OEM_BULK_SENSOR_READING_CMD 0x09
 
 #define POWER_CONTROL_LEN 0x01
 
@@ -437,6 +438,28 @@ struct _force_update_flag_get_cmd_resp {
 	uint8_t get_value;
 } __attribute__((packed));
 
+struct _bulk_sensor_reading_req {
+	uint8_t iana[IANA_LEN];
+	uint16_t start_sensor_id;
+	uint16_t end_sensor_id;
+} __attribute__((packed));
+
+struct _bulk_sensor_reading_entry {
+	uint16_t sensor_id;
+	uint8_t completion_code;
+	uint8_t sensor_operational_state;
+	int32_t present_reading;
+} __attribute__((packed));
+
+struct _bulk_sensor_reading_resp {
+	uint8_t completion_code;
+	uint8_t iana[IANA_LEN];
+	/* 0xFFFF once every sensor in the requested range has been returned */
+	uint16_t next_sensor_id;
+	uint16_t sensor_count;
+	struct _bulk_sensor_reading_entry entry[];
+} __attribute__((packed));
+
 uint8_t check_iana(const uint8_t *iana);
 uint8_t set_iana(uint8_t *buf, uint8_t buf_len);
 uint8_t send_event_log_to_bmc(struct pldm_addsel_data sel_msg);
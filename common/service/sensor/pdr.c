@@ -17,6 +17,7 @@
 #include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
+#include <sys/crc.h>
 #include "pdr.h"
 #include "sensor.h"
 #include "plat_sensor_table.h"
@@ -33,49 +34,90 @@ PDR_numeric_sensor *numeric_sensor_table = NULL;
 PDR_sensor_auxiliary_names *sensor_auxiliary_names_table = NULL;
 PDR_entity_auxiliary_names *entity_auxiliary_names_table = NULL;
 
+/* Every record serialized back to back, the typed tables above point into it */
+static uint8_t *pdr_repository = NULL;
+/* Byte offset of each record handle in pdr_repository, plus the end of the last record */
+static uint32_t *pdr_record_offset = NULL;
+static uint32_t pdr_repository_signature = 0;
+
+static void pdr_update_signature(void)
+{
+	pdr_repository_signature = crc32_ieee(pdr_repository, pdr_info->repository_size);
+}
+
+static void pdr_record_changed(PDR_common_header *header)
+{
+	header->record_change_number++;
+	pdr_update_signature();
+}
+
 int pdr_init(void)
 {
-	uint32_t pdr_count = 0, record_handle = 0x0, largest_record_size = 0;
+	uint32_t numeric_sensor_pdr_count = 0, aux_sensor_name_pdr_count = 0,
+		 entity_aux_name_pdr_count = 0;
+	uint32_t record_handle = 0x0, largest_record_size = 0, repository_size = 0, offset = 0;
+	uint16_t entity_aux_names_size = 0;
 
 	LOG_INF("pldm disable sensors count: 0x%x", plat_get_disabled_sensor_count());
 
-	pdr_count = plat_get_pdr_size(PLDM_NUMERIC_SENSOR_PDR);
-	if (pdr_count != 0) {
-		total_record_count += pdr_count;
-		numeric_sensor_table =
-			(PDR_numeric_sensor *)malloc(pdr_count * sizeof(PDR_numeric_sensor));
+	numeric_sensor_pdr_count = plat_get_pdr_size(PLDM_NUMERIC_SENSOR_PDR);
+	aux_sensor_name_pdr_count = plat_get_pdr_size(PLDM_SENSOR_AUXILIARY_NAMES_PDR);
+	entity_aux_name_pdr_count = plat_get_pdr_size(PLDM_ENTITY_AUXILIARY_NAMES_PDR);
+	if (entity_aux_name_pdr_count != 0) {
+		plat_init_entity_aux_names_pdr_table();
+		entity_aux_names_size = plat_get_pdr_entity_aux_names_size();
+	}
+
+	total_record_count =
+		numeric_sensor_pdr_count + aux_sensor_name_pdr_count + entity_aux_name_pdr_count;
+	repository_size = numeric_sensor_pdr_count * sizeof(PDR_numeric_sensor) +
+			  aux_sensor_name_pdr_count * sizeof(PDR_sensor_auxiliary_names) +
+			  entity_aux_name_pdr_count * entity_aux_names_size;
+
+	pdr_info = (PDR_INFO *)malloc(sizeof(PDR_INFO));
+	if (pdr_info == NULL) {
+		LOG_ERR("Failed to malloc PDR info");
+		return -1;
+	}
+	memset(pdr_info, 0, sizeof(PDR_INFO));
+	pdr_info->repository_state = PDR_STATE_AVAILABLE;
+
+	if (total_record_count == 0) {
+		return 0;
+	}
+
+	pdr_repository = (uint8_t *)malloc(repository_size);
+	pdr_record_offset = (uint32_t *)malloc((total_record_count + 1) * sizeof(uint32_t));
+	if ((pdr_repository == NULL) || (pdr_record_offset == NULL)) {
+		LOG_ERR("Failed to malloc PDR repository, size %u", repository_size);
+		SAFE_FREE(pdr_repository);
+		SAFE_FREE(pdr_record_offset);
+		total_record_count = 0;
+		pdr_info->repository_state = PDR_STATE_FAILED;
+		return -1;
+	}
+
+	if (numeric_sensor_pdr_count != 0) {
+		numeric_sensor_table = (PDR_numeric_sensor *)(pdr_repository + offset);
 		plat_load_numeric_sensor_pdr_table(numeric_sensor_table);
-		if (numeric_sensor_table == NULL) {
-			LOG_ERR("Failed to malloc numeric sensor PDR table");
-			return -1;
-		}
-		pdr_info->repository_size += pdr_count * sizeof(PDR_numeric_sensor);
 
-		for (uint32_t i = 0; i < pdr_count; i++) {
+		for (uint32_t i = 0; i < numeric_sensor_pdr_count; i++) {
 			numeric_sensor_table[i].pdr_common_header.record_handle = record_handle;
 			numeric_sensor_table[i].pdr_common_header.data_length +=
 				(sizeof(PDR_numeric_sensor) - sizeof(PDR_common_header));
-			record_handle++;
+			pdr_record_offset[record_handle++] = offset;
+			offset += sizeof(PDR_numeric_sensor);
 		}
 
-		if (largest_record_size < sizeof(PDR_numeric_sensor)) {
-			largest_record_size = sizeof(PDR_numeric_sensor);
-		}
+		largest_record_size = MAX(largest_record_size, sizeof(PDR_numeric_sensor));
 	}
 
-	pdr_count = plat_get_pdr_size(PLDM_SENSOR_AUXILIARY_NAMES_PDR);
-	if (pdr_count != 0) {
-		total_record_count += pdr_count;
-		sensor_auxiliary_names_table = (PDR_sensor_auxiliary_names *)malloc(
-			pdr_count * sizeof(PDR_sensor_auxiliary_names));
+	if (aux_sensor_name_pdr_count != 0) {
+		sensor_auxiliary_names_table =
+			(PDR_sensor_auxiliary_names *)(pdr_repository + offset);
 		plat_load_aux_sensor_names_pdr_table(sensor_auxiliary_names_table);
-		if (sensor_auxiliary_names_table == NULL) {
-			LOG_ERR("Failed to malloc sensor auxiliary names PDR table");
-			return -1;
-		}
-		pdr_info->repository_size += pdr_count * sizeof(PDR_sensor_auxiliary_names);
 
-		for (uint32_t i = 0; i < pdr_count; i++) {
+		for (uint32_t i = 0; i < aux_sensor_name_pdr_count; i++) {
 			sensor_auxiliary_names_table[i].pdr_common_header.record_handle =
 				record_handle;
 			sensor_auxiliary_names_table[i].pdr_common_header.data_length +=
@@ -88,55 +130,48 @@ int pdr_init(void)
 					sensor_auxiliary_names_table[i].sensorName[j]);
 			}
 
-			record_handle++;
+			pdr_record_offset[record_handle++] = offset;
+			offset += sizeof(PDR_sensor_auxiliary_names);
 		}
 
-		if (largest_record_size < sizeof(PDR_sensor_auxiliary_names)) {
-			largest_record_size = sizeof(PDR_sensor_auxiliary_names);
-		}
+		largest_record_size = MAX(largest_record_size, sizeof(PDR_sensor_auxiliary_names));
 	}
 
-	pdr_count = plat_get_pdr_size(PLDM_ENTITY_AUXILIARY_NAMES_PDR);
-	if (pdr_count != 0) {
-		plat_init_entity_aux_names_pdr_table();
-		total_record_count += pdr_count;
-		entity_auxiliary_names_table = (PDR_entity_auxiliary_names *)malloc(
-			pdr_count * plat_get_pdr_entity_aux_names_size());
+	if (entity_aux_name_pdr_count != 0) {
+		entity_auxiliary_names_table =
+			(PDR_entity_auxiliary_names *)(pdr_repository + offset);
 		plat_load_entity_aux_names_pdr_table(entity_auxiliary_names_table);
-		if (entity_auxiliary_names_table == NULL) {
-			LOG_ERR("Failed to malloc entity auxiliary names PDR table");
-			return -1;
-		}
-		pdr_info->repository_size += pdr_count * plat_get_pdr_entity_aux_names_size();
 
-		for (uint32_t i = 0; i < pdr_count; i++) {
-			entity_auxiliary_names_table[i].pdr_common_header.record_handle =
-				record_handle;
-			entity_auxiliary_names_table[i].pdr_common_header.data_length +=
-				(plat_get_pdr_entity_aux_names_size() - sizeof(PDR_common_header));
+		for (uint32_t i = 0; i < entity_aux_name_pdr_count; i++) {
+			// Entity names are variable length, step by the platform record size
+			PDR_entity_auxiliary_names *entity_aux_name =
+				(PDR_entity_auxiliary_names *)(pdr_repository + offset);
+
+			entity_aux_name->pdr_common_header.record_handle = record_handle;
+			entity_aux_name->pdr_common_header.data_length +=
+				(entity_aux_names_size - sizeof(PDR_common_header));
 			// Convert entity name to UTF16-BE
-			for (int j = 0; entity_auxiliary_names_table[i].entityName[j] != 0x0000;
-			     j++) {
-				entity_auxiliary_names_table[i].entityName[j] = sys_cpu_to_be16(
-					entity_auxiliary_names_table[i].entityName[j]);
+			for (int j = 0; entity_aux_name->entityName[j] != 0x0000; j++) {
+				entity_aux_name->entityName[j] =
+					sys_cpu_to_be16(entity_aux_name->entityName[j]);
 			}
 
-			record_handle++;
+			pdr_record_offset[record_handle++] = offset;
+			offset += entity_aux_names_size;
 		}
 
-		if (largest_record_size < sizeof(PDR_entity_auxiliary_names)) {
-			largest_record_size = sizeof(PDR_entity_auxiliary_names);
-		}
+		largest_record_size = MAX(largest_record_size, entity_aux_names_size);
 	}
 
-	pdr_info = (PDR_INFO *)malloc(sizeof(PDR_INFO));
-	if (pdr_info == NULL) {
-		LOG_ERR("Failed to malloc PDR info");
-		return false;
-	}
-	pdr_info->repository_state = PDR_STATE_AVAILABLE;
+	pdr_record_offset[record_handle] = offset;
+
 	pdr_info->record_count = total_record_count;
+	pdr_info->repository_size = repository_size;
 	pdr_info->largest_record_size = largest_record_size;
+	pdr_update_signature();
+
+	LOG_INF("PDR repository: %u records, %u bytes, signature 0x%x", total_record_count,
+		repository_size, pdr_repository_signature);
 
 	return 0;
 }
@@ -235,49 +270,36 @@ int pldm_get_sensor_name_via_sensor_id(uint16_t sensor_id, char *sensor_name, si
 	return -1;
 }
 
-int get_pdr_table_via_record_handle(uint8_t *record_data, uint32_t record_handle)
+const uint8_t *get_pdr_record_via_record_handle(uint32_t record_handle, uint16_t *record_len)
 {
-	uint32_t numeric_sensor_pdr_count = 0, aux_sensor_name_pdr_count = 0,
-		 entity_aux_name_pdr_count = 0;
+	CHECK_NULL_ARG_WITH_RETURN(record_len, NULL);
 
-	numeric_sensor_pdr_count = plat_get_pdr_size(PLDM_NUMERIC_SENSOR_PDR);
-	aux_sensor_name_pdr_count = plat_get_pdr_size(PLDM_SENSOR_AUXILIARY_NAMES_PDR);
-	entity_aux_name_pdr_count = plat_get_pdr_size(PLDM_ENTITY_AUXILIARY_NAMES_PDR);
+	if ((pdr_repository == NULL) || (record_handle >= total_record_count)) {
+		return NULL;
+	}
 
-	if (record_handle < numeric_sensor_pdr_count) {
-		for (int i = 0; i < numeric_sensor_pdr_count; i++) {
-			if (numeric_sensor_table[i].pdr_common_header.record_handle ==
-			    record_handle) {
-				memcpy(record_data, &numeric_sensor_table[i],
-				       sizeof(PDR_numeric_sensor));
-				return sizeof(PDR_numeric_sensor);
-			}
-		}
-	} else if (record_handle < numeric_sensor_pdr_count + aux_sensor_name_pdr_count) {
-		for (int i = 0; i < aux_sensor_name_pdr_count; i++) {
-			if (sensor_auxiliary_names_table[i].pdr_common_header.record_handle ==
-			    record_handle) {
-				memcpy(record_data, &sensor_auxiliary_names_table[i],
-				       sizeof(PDR_sensor_auxiliary_names));
-				return sizeof(PDR_sensor_auxiliary_names);
-			}
-		}
-	} else if (record_handle < numeric_sensor_pdr_count + aux_sensor_name_pdr_count +
-					   entity_aux_name_pdr_count) {
-		for (int i = 0; i < entity_aux_name_pdr_count; i++) {
-			if (entity_auxiliary_names_table[i].pdr_common_header.record_handle ==
-			    record_handle) {
-				memcpy(record_data, &entity_auxiliary_names_table[i],
-				       plat_get_pdr_entity_aux_names_size());
-				return plat_get_pdr_entity_aux_names_size();
-			}
-		}
-	} else {
+	*record_len = pdr_record_offset[record_handle + 1] - pdr_record_offset[record_handle];
+	return pdr_repository + pdr_record_offset[record_handle];
+}
+
+int get_pdr_table_via_record_handle(uint8_t *record_data, uint32_t record_handle)
+{
+	CHECK_NULL_ARG_WITH_RETURN(record_data, -1);
+
+	uint16_t record_len = 0;
+	const uint8_t *record = get_pdr_record_via_record_handle(record_handle, &record_len);
+	if (record == NULL) {
 		LOG_ERR("Failed to get PDR via record handle: %x\n", record_handle);
 		return -1;
 	}
 
-	return -1;
+	memcpy(record_data, record, record_len);
+	return record_len;
+}
+
+uint32_t get_pdr_repository_signature()
+{
+	return pdr_repository_signature;
 }
 
 uint32_t get_record_count()
@@ -340,6 +362,7 @@ int change_pdr_table_critical_high_with_sensor_id(uint32_t sensorID, uint32_t cr
 	for (int i = 0; i < numeric_sensor_pdr_count; i++) {
 		if (numeric_sensor_table[i].sensor_id == sensorID) {
 			numeric_sensor_table[i].critical_high = (int32_t)critical_high;
+			pdr_record_changed(&numeric_sensor_table[i].pdr_common_header);
 
 			LOG_DBG("SET critical_high - sensorID: 0x%x, unit_modifier: %d, critical_high stored: %d",
 				sensorID, numeric_sensor_table[i].unit_modifier,
@@ -359,6 +382,7 @@ int change_pdr_table_critical_low_with_sensor_id(uint32_t sensorID, uint32_t cri
 	for (int i = 0; i < numeric_sensor_pdr_count; i++) {
 		if (numeric_sensor_table[i].sensor_id == sensorID) {
 			numeric_sensor_table[i].critical_low = (int32_t)critical_low;
+			pdr_record_changed(&numeric_sensor_table[i].pdr_common_header);
 
 			LOG_DBG("SET critical_low - sensorID: 0x%x, unit_modifier: %d, critical_low stored: %d",
 				sensorID, numeric_sensor_table[i].unit_modifier,
@@ -172,6 +172,8 @@ void plat_load_aux_sensor_names_pdr_table(PDR_sensor_auxiliary_names *aux_sensor
 void plat_load_entity_aux_names_pdr_table(PDR_entity_auxiliary_names *entity_aux_name_table);
 int pldm_get_sensor_name_via_sensor_id(uint16_t sensor_id, char *sensor_name, size_t max_length);
 int get_pdr_table_via_record_handle(uint8_t *record_data, uint32_t record_handle);
+const uint8_t *get_pdr_record_via_record_handle(uint32_t record_handle, uint16_t *record_len);
+uint32_t get_pdr_repository_signature();
 void plat_init_entity_aux_names_pdr_table();
 uint16_t plat_get_pdr_entity_aux_names_size();
 uint16_t plat_get_disabled_sensor_count();
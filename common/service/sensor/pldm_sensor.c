@@ -20,6 +20,7 @@
 #include "pldm_monitor.h"
 #include "plat_def.h"
 #include "sensor.h"
+#include "sensor_energy.h"
 
 #ifdef ENABLE_PLDM_SENSOR
 #include "plat_pldm_sensor.h"
@@ -38,6 +39,20 @@ K_THREAD_STACK_ARRAY_DEFINE(pldm_sensor_poll_stacks, MAX_SENSOR_THREAD_ID,
 pldm_sensor_thread *pldm_sensor_thread_list;
 pldm_sensor_info *pldm_sensor_list[MAX_SENSOR_THREAD_ID];
 
+typedef struct _pldm_sensor_index_entry {
+	uint16_t sensor_id;
+	uint16_t sensor_index;
+	uint8_t thread_id;
+	bool used;
+} pldm_sensor_index_entry;
+
+/* Open addressing hash table of sensor_id, built once every polling thread loaded its list */
+static pldm_sensor_index_entry *pldm_sensor_index_table = NULL;
+static uint16_t pldm_sensor_index_mask = 0;
+static bool pldm_sensor_index_ready = false;
+static uint8_t pldm_sensor_loaded_thread_count = 0;
+K_MUTEX_DEFINE(pldm_sensor_index_mutex);
+
 __weak pldm_sensor_thread *plat_pldm_sensor_load_thread()
 {
 	return NULL;
@@ -174,39 +189,215 @@ int pldm_sensor_get_info_via_sensor_thread_and_sensor_pdr_index(
 	return 0;
 }
 
-int pldm_sensor_get_info_via_sensor_id(uint16_t sensor_id, float *resolution, float *offset,
-				       int8_t *unit_modifier, int *cache,
-				       uint8_t *sensor_operational_state)
+static void pldm_sensor_index_build(void)
 {
-	CHECK_NULL_ARG_WITH_RETURN(resolution, -1);
-	CHECK_NULL_ARG_WITH_RETURN(offset, -1);
-	CHECK_NULL_ARG_WITH_RETURN(unit_modifier, -1);
-	CHECK_NULL_ARG_WITH_RETURN(cache, -1);
-	CHECK_NULL_ARG_WITH_RETURN(sensor_operational_state, -1);
+	int t_id = 0, s_id = 0, pldm_sensor_count = 0;
+	uint32_t total = 0, size = 1;
+
+	for (t_id = 0; t_id < MAX_SENSOR_THREAD_ID; t_id++) {
+		pldm_sensor_count = plat_pldm_sensor_get_sensor_count(t_id);
+		if ((pldm_sensor_list[t_id] != NULL) && (pldm_sensor_count > 0)) {
+			total += pldm_sensor_count;
+		}
+	}
+
+	// Keep load factor under half so probing stays short
+	while (size < (total * 2)) {
+		size <<= 1;
+	}
+
+	if ((total == 0) || (size > UINT16_MAX)) {
+		LOG_WRN("Skip PLDM sensor index, sensor count: %d", total);
+		return;
+	}
+
+	pldm_sensor_index_table =
+		(pldm_sensor_index_entry *)calloc(size, sizeof(pldm_sensor_index_entry));
+	if (pldm_sensor_index_table == NULL) {
+		LOG_ERR("Failed to allocate PLDM sensor index table");
+		return;
+	}
+	pldm_sensor_index_mask = size - 1;
+
+	for (t_id = 0; t_id < MAX_SENSOR_THREAD_ID; t_id++) {
+		if (pldm_sensor_list[t_id] == NULL) {
+			continue;
+		}
+
+		pldm_sensor_count = plat_pldm_sensor_get_sensor_count(t_id);
+		for (s_id = 0; s_id < pldm_sensor_count; s_id++) {
+			uint16_t sensor_id =
+				pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.sensor_id;
+			uint16_t slot = sensor_id & pldm_sensor_index_mask;
+
+			while (pldm_sensor_index_table[slot].used) {
+				if (pldm_sensor_index_table[slot].sensor_id == sensor_id) {
+					break;
+				}
+				slot = (slot + 1) & pldm_sensor_index_mask;
+			}
+
+			// Keep the first match, same as the list scan order
+			if (pldm_sensor_index_table[slot].used) {
+				LOG_WRN("Duplicate PLDM sensor id 0x%x in thread %d", sensor_id,
+					t_id);
+				continue;
+			}
+
+			pldm_sensor_index_table[slot].sensor_id = sensor_id;
+			pldm_sensor_index_table[slot].sensor_index = s_id;
+			pldm_sensor_index_table[slot].thread_id = t_id;
+			pldm_sensor_index_table[slot].used = true;
+		}
+	}
+
+	pldm_sensor_index_ready = true;
+	LOG_INF("PLDM sensor index built, %d sensors in %d slots", total, size);
+}
+
+/* Every polling thread reports once it loaded (or failed to load) its sensor list */
+static void pldm_sensor_index_thread_loaded(void)
+{
+	k_mutex_lock(&pldm_sensor_index_mutex, K_FOREVER);
+
+	pldm_sensor_loaded_thread_count++;
+	if (pldm_sensor_loaded_thread_count == MAX_SENSOR_THREAD_ID) {
+		pldm_sensor_index_build();
+	}
+
+	k_mutex_unlock(&pldm_sensor_index_mutex);
+}
 
+pldm_sensor_info *pldm_sensor_find_info_via_sensor_id(uint16_t sensor_id)
+{
 	int t_id = 0, s_id = 0, pldm_sensor_count = 0;
 
+	if (pldm_sensor_index_ready) {
+		uint16_t slot = sensor_id & pldm_sensor_index_mask;
+
+		while (pldm_sensor_index_table[slot].used) {
+			pldm_sensor_index_entry *entry = &pldm_sensor_index_table[slot];
+			if (entry->sensor_id == sensor_id) {
+				return &pldm_sensor_list[entry->thread_id][entry->sensor_index];
+			}
+			slot = (slot + 1) & pldm_sensor_index_mask;
+		}
+
+		return NULL;
+	}
+
+	// Index is not ready before all polling threads loaded their lists
 	for (t_id = 0; t_id < MAX_SENSOR_THREAD_ID; t_id++) {
+		if (pldm_sensor_list[t_id] == NULL) {
+			continue;
+		}
+
 		pldm_sensor_count = plat_pldm_sensor_get_sensor_count(t_id);
 		for (s_id = 0; s_id < pldm_sensor_count; s_id++) {
 			if (sensor_id ==
 			    pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.sensor_id) {
-				// Get from numeric sensor PDR
-				*resolution =
-					pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.resolution;
-				*offset = pldm_sensor_list[t_id][s_id].pdr_numeric_sensor.offset;
-				*unit_modifier = pldm_sensor_list[t_id][s_id]
-							 .pdr_numeric_sensor.unit_modifier;
-				// Get from sensor config
-				*cache = pldm_sensor_list[t_id][s_id].pldm_sensor_cfg.cache;
-				*sensor_operational_state =
-					pldm_sensor_list[t_id][s_id].pldm_sensor_cfg.cache_status;
-				return 0;
+				return &pldm_sensor_list[t_id][s_id];
 			}
 		}
 	}
 
-	return -1;
+	return NULL;
+}
+
+int pldm_sensor_get_info_via_sensor_id(uint16_t sensor_id, float *resolution, float *offset,
+				       int8_t *unit_modifier, int *cache,
+				       uint8_t *sensor_operational_state)
+{
+	CHECK_NULL_ARG_WITH_RETURN(resolution, -1);
+	CHECK_NULL_ARG_WITH_RETURN(offset, -1);
+	CHECK_NULL_ARG_WITH_RETURN(unit_modifier, -1);
+	CHECK_NULL_ARG_WITH_RETURN(cache, -1);
+	CHECK_NULL_ARG_WITH_RETURN(sensor_operational_state, -1);
+
+	pldm_sensor_info *info = pldm_sensor_find_info_via_sensor_id(sensor_id);
+	if (info == NULL) {
+		return -1;
+	}
+
+	// Get from numeric sensor PDR
+	*resolution = info->pdr_numeric_sensor.resolution;
+	*offset = info->pdr_numeric_sensor.offset;
+	*unit_modifier = info->pdr_numeric_sensor.unit_modifier;
+	// Get from sensor config
+	*cache = info->pldm_sensor_cfg.cache;
+	*sensor_operational_state = info->pldm_sensor_cfg.cache_status;
+
+	return 0;
+}
+
+/* Fold Y = (X * resolution + offset) * 10^unit_modifier into fixed point once per sensor */
+static void pldm_sensor_init_conversion(pldm_sensor_info *info)
+{
+	const PDR_numeric_sensor *pdr = &info->pdr_numeric_sensor;
+
+	info->reading_scale = 0;
+	info->reading_offset = 0;
+	info->reading_shift = 0;
+
+	if (pdr->resolution == 0) {
+		return;
+	}
+
+	// X = (Y_milli * power (10, -1 * unit_modifier) / 1000 - offset ) / resolution
+	double scale = power(10, -1 * pdr->unit_modifier) / (1000.0 * pdr->resolution);
+	double scale_abs = (scale < 0) ? -scale : scale;
+	double offset = -pdr->offset / pdr->resolution;
+	double offset_abs = (offset < 0) ? -offset : offset;
+	uint8_t shift = 0;
+
+	// Take as many fraction bits as keep the scale within 31 bits and the offset within 62
+	while ((shift < PLDM_SENSOR_READING_SHIFT_MAX) &&
+	       ((scale_abs * (double)(1ULL << (shift + 1))) < INT32_MAX) &&
+	       ((offset_abs * (double)(1ULL << (shift + 1))) < (double)(1ULL << 62))) {
+		shift++;
+	}
+
+	if ((scale_abs * (double)(1ULL << shift)) >= INT32_MAX) {
+		LOG_WRN("PLDM sensor 0x%x resolution out of range", pdr->sensor_id);
+		return;
+	}
+
+	double one = (double)(1ULL << shift);
+	info->reading_shift = shift;
+	info->reading_scale = (int32_t)((scale * one) + ((scale < 0) ? -0.5 : 0.5));
+	info->reading_offset = (int64_t)(offset * one);
+
+	// A large positive unit_modifier rounds the scale to 0, clamp it to the smallest step so
+	// readings encode as 0 instead of the sensor being reported as invalid
+	if (info->reading_scale == 0) {
+		info->reading_scale = (scale < 0) ? -1 : 1;
+	}
+}
+
+static int32_t pldm_sensor_encode_reading(const pldm_sensor_info *info, int cache_reading)
+{
+	// Two byte integer, two byte decimal (milli) sensor format
+	int16_t integer = cache_reading & 0xffff;
+	int16_t decimal = cache_reading >> 16;
+	int64_t milli = (int64_t)integer * 1000 + ((integer >= 0) ? decimal : -decimal);
+	int64_t value = milli * info->reading_scale + info->reading_offset;
+
+	// Truncate toward zero as the float conversion did
+	if (value >= 0) {
+		return (int32_t)(value >> info->reading_shift);
+	}
+	return -(int32_t)((-value) >> info->reading_shift);
+}
+
+/* Only the polling thread of the sensor refreshes the encoded reading */
+static void pldm_sensor_update_encoded_reading(pldm_sensor_info *info)
+{
+	int cache_reading = info->pldm_sensor_cfg.cache;
+
+	info->encoded_reading = pldm_sensor_encode_reading(info, cache_reading);
+	// Publish the reading before the cache it belongs to
+	compiler_barrier();
+	info->encoded_cache = cache_reading;
 }
 
 uint8_t pldm_sensor_get_reading_from_cache(uint16_t sensor_id, int *reading,
@@ -215,38 +406,27 @@ uint8_t pldm_sensor_get_reading_from_cache(uint16_t sensor_id, int *reading,
 	CHECK_NULL_ARG_WITH_RETURN(reading, PLDM_ERROR);
 	CHECK_NULL_ARG_WITH_RETURN(sensor_operational_state, PLDM_ERROR);
 
-	float sensor_reading = 0, decimal = 0, resolution = 0, offset = 0;
-	int cache_reading = 0;
-	int8_t unit_modifier = 0;
-	int16_t integer = 0;
-
-	if (pldm_sensor_get_info_via_sensor_id(sensor_id, &resolution, &offset, &unit_modifier,
-					       &cache_reading, sensor_operational_state) != 0) {
+	const pldm_sensor_info *info = pldm_sensor_find_info_via_sensor_id(sensor_id);
+	if (info == NULL) {
 		// Couldn't find sensor id in pldm_sensor_list
 		return PLDM_PLATFORM_INVALID_SENSOR_ID;
 	}
 
-	if (resolution == 0) {
+	*sensor_operational_state = info->pldm_sensor_cfg.cache_status;
+
+	if (info->reading_scale == 0) {
 		// The value of resolution couldn't be 0
 		return PLDM_ERROR_INVALID_DATA;
 	}
 
-	// Convert two byte integer, two byte decimal sensor format to float
-	integer = cache_reading & 0xffff;
-	decimal = (float)(cache_reading >> 16) / 1000.0;
-
-	if (integer >= 0) {
-		sensor_reading = (float)integer + decimal;
+	// Cache written outside the polling loop (e.g. APML callback) is encoded on demand
+	int cache_reading = info->pldm_sensor_cfg.cache;
+	if (cache_reading == info->encoded_cache) {
+		*reading = info->encoded_reading;
 	} else {
-		sensor_reading = (float)integer - decimal;
+		*reading = pldm_sensor_encode_reading(info, cache_reading);
 	}
 
-	// Y = converted reading in Units in BMC
-	// X = sensor reading report to BMC
-	// Y = (X * resolution + offset ) * power (10, unit_modifier)
-	// X = (Y * power (10, -1 * unit_modifier) - offset ) / resolution
-	*reading = (int)((sensor_reading * power(10, -1 * unit_modifier) - offset) / resolution);
-
 	return PLDM_SUCCESS;
 }
 
@@ -346,6 +526,154 @@ void pldm_sensor_get_reading(sensor_cfg *pldm_sensor_cfg, uint32_t *update_time,
 	pldm_sensor_cfg->cache_status = PLDM_SENSOR_ENABLED;
 }
 
+#ifdef ENABLE_PLDM_SENSOR_THRESHOLD_EVENT
+__weak uint32_t plat_pldm_sensor_get_hysteresis(pldm_sensor_info *info)
+{
+	CHECK_NULL_ARG_WITH_RETURN(info, 0);
+
+	return info->pdr_numeric_sensor.hysteresis;
+}
+
+/* Normal is 0, upper states count up and lower states count down by severity */
+static int8_t pldm_sensor_state_level(uint8_t state)
+{
+	switch (state) {
+	case PLDM_SENSOR_UPPERWARNING:
+		return 1;
+	case PLDM_SENSOR_UPPERCRITICAL:
+		return 2;
+	case PLDM_SENSOR_UPPERFATAL:
+		return 3;
+	case PLDM_SENSOR_LOWERWARNING:
+		return -1;
+	case PLDM_SENSOR_LOWERCRITICAL:
+		return -2;
+	case PLDM_SENSOR_LOWERFATAL:
+		return -3;
+	default:
+		return 0;
+	}
+}
+
+static uint8_t pldm_sensor_threshold_state(const PDR_numeric_sensor *pdr, int64_t reading)
+{
+	uint8_t thresholds = pdr->supported_thresholds;
+
+	if ((thresholds & UP_THRESHOLD_FATAL) && (reading > pdr->fatal_high)) {
+		return PLDM_SENSOR_UPPERFATAL;
+	}
+	if ((thresholds & UP_THRESHOLD_CRIT) && (reading > pdr->critical_high)) {
+		return PLDM_SENSOR_UPPERCRITICAL;
+	}
+	if ((thresholds & UP_THRESHOLD_WARN) && (reading > pdr->warning_high)) {
+		return PLDM_SENSOR_UPPERWARNING;
+	}
+	if ((thresholds & LOW_THRESHOLD_FATAL) && (reading < pdr->fatal_low)) {
+		return PLDM_SENSOR_LOWERFATAL;
+	}
+	if ((thresholds & LOW_THRESHOLD_CRIT) && (reading < pdr->critical_low)) {
+		return PLDM_SENSOR_LOWERCRITICAL;
+	}
+	if ((thresholds & LOW_THRESHOLD_WARN) && (reading < pdr->warning_low)) {
+		return PLDM_SENSOR_LOWERWARNING;
+	}
+
+	return PLDM_SENSOR_NORMAL;
+}
+
+/* A state only steps back toward normal once the reading clears its threshold by hysteresis */
+static uint8_t pldm_sensor_eval_state(pldm_sensor_info *info, int reading)
+{
+	const PDR_numeric_sensor *pdr = &info->pdr_numeric_sensor;
+	uint32_t hysteresis = plat_pldm_sensor_get_hysteresis(info);
+	uint8_t state = pldm_sensor_threshold_state(pdr, reading);
+	int8_t level = pldm_sensor_state_level(state);
+	int8_t present_level = pldm_sensor_state_level(info->present_state);
+	uint8_t held;
+
+	if ((present_level > 0) && (level >= 0) && (level < present_level)) {
+		held = pldm_sensor_threshold_state(pdr, (int64_t)reading + hysteresis);
+		if (pldm_sensor_state_level(held) >= present_level) {
+			return info->present_state;
+		}
+		return held;
+	}
+
+	if ((present_level < 0) && (level <= 0) && (level > present_level)) {
+		held = pldm_sensor_threshold_state(pdr, (int64_t)reading - hysteresis);
+		if (pldm_sensor_state_level(held) <= present_level) {
+			return info->present_state;
+		}
+		return held;
+	}
+
+	return state;
+}
+
+/* Track numericSensorState of a fresh reading and send a sensorEvent on every transition */
+static void pldm_sensor_check_threshold(pldm_sensor_info *info)
+{
+	CHECK_NULL_ARG(info);
+
+	PDR_numeric_sensor *pdr = &info->pdr_numeric_sensor;
+
+	if ((pdr->supported_thresholds == 0) || (info->reading_scale == 0) ||
+	    (info->pldm_sensor_cfg.cache_status != PLDM_SENSOR_ENABLED)) {
+		return;
+	}
+
+	int reading = info->encoded_reading;
+	uint8_t state = pldm_sensor_eval_state(info, reading);
+	uint8_t previous = info->present_state;
+
+	if (state == previous) {
+		return;
+	}
+
+	info->previous_state = previous;
+	info->present_state = state;
+
+	/* First evaluation of a sensor in range is not an event */
+	if ((previous == PLDM_SENSOR_UNKNOWN) && (state == PLDM_SENSOR_NORMAL)) {
+		return;
+	}
+
+	uint8_t data_size = get_sensor_data_size(pdr->sensor_data_size);
+	uint8_t buf[sizeof(struct pldm_sensor_event_numeric_sensor_state) - 1 + sizeof(reading)];
+	struct pldm_sensor_event_numeric_sensor_state *event =
+		(struct pldm_sensor_event_numeric_sensor_state *)buf;
+
+	event->event_state = state;
+	event->previous_event_state = previous;
+	event->sensor_data_size = pdr->sensor_data_size;
+	memcpy(event->present_reading, &reading, data_size);
+
+	LOG_WRN("PLDM sensor 0x%x state 0x%x -> 0x%x, reading %d", pdr->sensor_id, previous,
+		state, reading);
+
+	if (pldm_send_platform_event(PLDM_SENSOR_EVENT, pdr->sensor_id, PLDM_NUMERIC_SENSOR_STATE,
+				     buf, sizeof(*event) - 1 + data_size) != PLDM_SUCCESS) {
+		LOG_ERR("Failed to send sensor 0x%x threshold event", pdr->sensor_id);
+	}
+}
+
+bool pldm_sensor_get_threshold_state(uint16_t sensor_id, uint8_t *present_state,
+				     uint8_t *previous_state)
+{
+	CHECK_NULL_ARG_WITH_RETURN(present_state, false);
+	CHECK_NULL_ARG_WITH_RETURN(previous_state, false);
+
+	pldm_sensor_info *info = pldm_sensor_find_info_via_sensor_id(sensor_id);
+	if ((info == NULL) || (info->pdr_numeric_sensor.supported_thresholds == 0)) {
+		return false;
+	}
+
+	*present_state = info->present_state;
+	*previous_state = info->previous_state;
+	return true;
+}
+#endif
+
 int pldm_sensor_polling_pre_check(pldm_sensor_info *pldm_snr_list, int sensor_num)
 {
 	CHECK_NULL_ARG_WITH_RETURN(pldm_snr_list, -1);
@@ -371,6 +699,9 @@ int pldm_sensor_polling_pre_check(pldm_sensor_info *pldm_snr_list, int sensor_nu
 		return -1;
 	}
 
+	// A device being (re)initialized may have restarted its energy counters
+	sensor_energy_reset(&pldm_snr_list->pldm_sensor_cfg);
+
 	ret = sensor_drive_tbl[pldm_snr_list->pldm_sensor_cfg.type].init(
 		&pldm_snr_list->pldm_sensor_cfg);
 	if (ret != SENSOR_INIT_SUCCESS) {
@@ -418,6 +749,10 @@ int pldm_polling_sensor_reading_optional_check(pldm_sensor_info *pldm_snr_list,
 	pldm_sensor_get_reading(&pldm_snr_list->pldm_sensor_cfg, &pldm_snr_list->update_time,
 				&pldm_snr_list->update_time_ms, pldm_sensor_count, thread_id,
 				sensor_num);
+	pldm_sensor_update_encoded_reading(pldm_snr_list);
+#ifdef ENABLE_PLDM_SENSOR_THRESHOLD_EVENT
+	pldm_sensor_check_threshold(pldm_snr_list);
+#endif
 
 	LOG_DBG("sensor0x%x, value0x%x, status 0x%x", pldm_snr_list->pdr_numeric_sensor.sensor_id,
 		pldm_snr_list->pldm_sensor_cfg.cache, pldm_snr_list->pldm_sensor_cfg.cache_status);
@@ -448,10 +783,21 @@ void pldm_sensor_polling_handler(void *arug0, void *arug1, void *arug2)
 	if (pldm_sensor_count <= 0) {
 		LOG_ERR("Failed to get PLDM sensor count(%d) of thread%d", pldm_sensor_count,
 			thread_id);
+		pldm_sensor_index_thread_loaded();
 		return;
 	}
 
-	pldm_sensor_list[thread_id] = plat_pldm_sensor_load(thread_id);
+	pldm_sensor_info *sensor_list = plat_pldm_sensor_load(thread_id);
+	if (sensor_list != NULL) {
+		// Conversion is ready before readers can find the sensors
+		for (sensor_num = 0; sensor_num < pldm_sensor_count; sensor_num++) {
+			pldm_sensor_init_conversion(&sensor_list[sensor_num]);
+			pldm_sensor_update_encoded_reading(&sensor_list[sensor_num]);
+		}
+	}
+
+	pldm_sensor_list[thread_id] = sensor_list;
+	pldm_sensor_index_thread_loaded();
 	if (pldm_sensor_list[thread_id] == NULL) {
 		LOG_ERR("Failed to load PLDM sensor list of thread%d, ret%d", thread_id, ret);
 		return;
@@ -471,6 +817,12 @@ void pldm_sensor_polling_handler(void *arug0, void *arug1, void *arug2)
 
 	plat_pldm_sensor_post_load_init(thread_id);
 
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+	// Rails sharing a device page are polled back to back
+	uint16_t *poll_order = sensor_build_poll_order(&sensor_list[0].pldm_sensor_cfg,
+						       sizeof(pldm_sensor_info), pldm_sensor_count);
+#endif
+
 	while (1) {
 		// Check sensor poll enable
 		if (get_sensor_poll_enable_flag() == false) {
@@ -480,11 +832,17 @@ void pldm_sensor_polling_handler(void *arug0, void *arug1, void *arug2)
 		// Dynamic change polling interval
 		plat_pldm_sensor_change_poll_interval(thread_id, &poll_interval_ms);
 
-		for (sensor_num = 0; sensor_num < pldm_sensor_count; sensor_num++) {
+		for (int poll_index = 0; poll_index < pldm_sensor_count; poll_index++) {
 			if (get_sensor_poll_enable_flag() == false) {
 				break;
 			}
 
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+			sensor_num = (poll_order != NULL) ? poll_order[poll_index] : poll_index;
+#else
+			sensor_num = poll_index;
+#endif
+
 			if (pldm_sensor_thread_list[thread_id].poll_interval_ms != 0) {
 				if (pldm_polling_sensor_reading_optional_check(
 					    &pldm_sensor_list[thread_id][sensor_num],
@@ -528,6 +886,7 @@ void pldm_sensor_poll_thread_init()
 #ifdef ENABLE_PLATFORM_PROVIDES_PLDM_SENSOR_STACKS
 		if (stack == NULL || stack_size == 0) {
 			LOG_WRN("Invalid stack for thread %d, skipping", i);
+			pldm_sensor_index_thread_loaded();
 			continue;
 		}
 #else
@@ -548,6 +907,7 @@ void pldm_sensor_poll_thread_init()
 		if (pldm_sensor_polling_tid[i] == NULL) {
 			LOG_ERR("Failed to create %s to monitor sensor",
 				pldm_sensor_thread_list[i].thread_name);
+			pldm_sensor_index_thread_loaded();
 		}
 	}
 
@@ -24,6 +24,8 @@
 #define PLDM_SENSOR_POLL_STACK_SIZE 3056
 
 #define PLDM_SENSOR_POLL_TIME_DEFAULT_MS 1000
+/* Fraction bits of the fixed point reading conversion */
+#define PLDM_SENSOR_READING_SHIFT_MAX 48
 
 enum {
 	UP_THRESHOLD_WARN = 0x01,
@@ -40,6 +42,16 @@ typedef struct pldm_sensor_info {
 	sensor_cfg pldm_sensor_cfg;
 	uint32_t update_time_ms;
 	uint16_t poll_interval_ms;
+	/* numericSensorState from the PDR thresholds, see ENABLE_PLDM_SENSOR_THRESHOLD_EVENT */
+	uint8_t present_state;
+	uint8_t previous_state;
+	/* PDR transform as X = (Y_milli * reading_scale + reading_offset) >> reading_shift */
+	int64_t reading_offset;
+	int32_t reading_scale;
+	uint8_t reading_shift;
+	/* Last polled cache and its PDR encoded reading */
+	int encoded_cache;
+	int32_t encoded_reading;
 } pldm_sensor_info;
 
 typedef struct pldm_sensor_thread {
@@ -74,8 +86,12 @@ int pldm_polling_sensor_reading_optional_check(pldm_sensor_info *pldm_snr_list,
 					       int pldm_sensor_count, int thread_id, int sensor_num,
 					       bool interval_ready_check_en, bool polling_using_ms);
 pldm_sensor_thread *pldm_sensor_get_thread_info(int thread_id);
+pldm_sensor_info *pldm_sensor_find_info_via_sensor_id(uint16_t sensor_id);
 int pldm_sensor_get_info_via_sensor_id(uint16_t sensor_id, float *resolution, float *offset,
 				       int8_t *unit_modifier, int *cache,
 				       uint8_t *sensor_operational_state);
+bool pldm_sensor_get_threshold_state(uint16_t sensor_id, uint8_t *present_state,
+				     uint8_t *previous_state);
+uint32_t plat_pldm_sensor_get_hysteresis(pldm_sensor_info *info);
 
 #endif
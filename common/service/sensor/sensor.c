@@ -30,8 +30,12 @@
 #include "ads7830.h"
 #include "intel_peci.h"
 #include "util_sys.h"
+#include "sensor_energy.h"
 #include "plat_def.h"
 #include "libutil.h"
+#ifdef ENABLE_PMBUS_REG_CACHE
+#include "util_pmbus.h"
+#endif
 
 #include <logging/log.h>
 
@@ -51,6 +55,10 @@ LOG_MODULE_REGISTER(sensor);
 
 #define SENSOR_READ_RETRY_MAX 3
 
+#ifndef SENSOR_ENERGY_READ_WINDOW_MS
+#define SENSOR_ENERGY_READ_WINDOW_MS SENSOR_ENERGY_READ_WINDOW_MS_DEFAULT
+#endif
+
 extern sensor_cfg plat_sensor_config[];
 extern const int SENSOR_CONFIG_SIZE;
 
@@ -64,6 +72,7 @@ bool enable_sensor_poll_thread = true;
 static bool sensor_poll_enable_flag = true;
 static bool is_sensor_initial_done = false;
 static bool is_sensor_ready_flag = false;
+static int sensor_poll_interval_ms = 1000;
 
 const int negative_ten_power[16] = { 1,	    1,		1,	   1,	     1,	      1,
 				     1,	    1000000000, 100000000, 10000000, 1000000, 100000,
@@ -822,33 +831,72 @@ static void init_sensor_num(void)
 
 void map_sensor_num_to_sdr_cfg(void)
 {
-	uint8_t i, j;
+	uint8_t index = 0;
+	uint8_t sensor_num = 0;
 
-	for (i = 0; i < SENSOR_NUM_MAX; i++) {
-		for (j = 0; j < sdr_count; j++) {
-			if (i == full_sdr_table[j].sensor_num) {
-				sdr_index_map[i] = j;
-				break;
-			} else if (i == sdr_count) {
-				sdr_index_map[i] = SENSOR_NULL;
-			} else {
-				continue;
-			}
+	init_sensor_num();
+
+	// Keep the first match of each sensor number, same as the table scan order
+	for (index = 0; index < sdr_count; index++) {
+		sensor_num = full_sdr_table[index].sensor_num;
+		if ((sensor_num < SENSOR_NUM_MAX) && (sdr_index_map[sensor_num] == SENSOR_NULL)) {
+			sdr_index_map[sensor_num] = index;
 		}
-		for (j = 0; j < sdr_count; j++) {
-			if (i == sensor_config[j].num) {
-				sensor_config_index_map[i] = j;
-				break;
-			} else if (i == sdr_count) {
-				sensor_config_index_map[i] = SENSOR_NULL;
-			} else {
-				continue;
-			}
+	}
+
+	for (index = 0; index < sensor_config_count; index++) {
+		sensor_num = sensor_config[index].num;
+		if ((sensor_num < SENSOR_NUM_MAX) &&
+		    (sensor_config_index_map[sensor_num] == SENSOR_NULL)) {
+			sensor_config_index_map[sensor_num] = index;
 		}
 	}
 	return;
 }
 
+/* Sensor number to config index map of each monitor table, table 0 uses sensor_config_index_map */
+static uint8_t *sensor_monitor_index_map = NULL;
+static uint16_t sensor_monitor_index_map_count = 0;
+
+void init_sensor_monitor_index_map(void)
+{
+	SAFE_FREE(sensor_monitor_index_map);
+	sensor_monitor_index_map_count = 0;
+
+	if (sensor_monitor_count <= 1) {
+		return;
+	}
+
+	sensor_monitor_index_map = (uint8_t *)malloc(sensor_monitor_count * SENSOR_NUM_MAX);
+	if (sensor_monitor_index_map == NULL) {
+		LOG_ERR("Fail to allocate memory to sensor monitor index map");
+		return;
+	}
+
+	memset(sensor_monitor_index_map, SENSOR_NULL, sensor_monitor_count * SENSOR_NUM_MAX);
+	sensor_monitor_index_map_count = sensor_monitor_count;
+}
+
+static uint8_t *get_sensor_index_map(sensor_cfg *cfg_table)
+{
+	if (cfg_table == sensor_config) {
+		return sensor_config_index_map;
+	}
+
+	if (sensor_monitor_index_map == NULL) {
+		return NULL;
+	}
+
+	for (uint16_t table_index = 1; table_index < sensor_monitor_index_map_count;
+	     ++table_index) {
+		if (sensor_monitor_table[table_index].monitor_sensor_cfg == cfg_table) {
+			return &sensor_monitor_index_map[table_index * SENSOR_NUM_MAX];
+		}
+	}
+
+	return NULL;
+}
+
 __weak sensor_cfg *get_common_sensor_cfg_info(uint8_t sensor_num)
 {
 	if (!sensor_monitor_table)
@@ -870,9 +918,25 @@ sensor_cfg *find_sensor_cfg_via_sensor_num(sensor_cfg *cfg_table, uint8_t cfg_co
 	CHECK_NULL_ARG_WITH_RETURN(cfg_table, false);
 
 	uint8_t index = 0;
+	uint8_t *index_map = NULL;
+
+	if (sensor_num < SENSOR_NUM_MAX) {
+		index_map = get_sensor_index_map(cfg_table);
+	}
 
+	if (index_map != NULL) {
+		index = index_map[sensor_num];
+		if ((index < cfg_count) && (cfg_table[index].num == sensor_num)) {
+			return &cfg_table[index];
+		}
+	}
+
+	// Table changed after the map was built, fall back to scan and refresh the map entry
 	for (index = 0; index < cfg_count; ++index) {
 		if (cfg_table[index].num == sensor_num) {
+			if (index_map != NULL) {
+				index_map[sensor_num] = index;
+			}
 			return &cfg_table[index];
 		}
 	}
@@ -1021,6 +1085,19 @@ uint8_t get_sensor_reading(sensor_cfg *cfg_table, uint8_t cfg_count, uint8_t sen
 			return cfg->cache_status;
 		}
 		break;
+	case GET_FROM_ENERGY_ACCUM: {
+		// Average power over the recent window instead of the last poll interval only
+		double power = 0;
+		if (sensor_energy_get_average_power(cfg, SENSOR_ENERGY_READ_WINDOW_MS, &power,
+						    NULL) != 0) {
+			return SENSOR_UNAVAILABLE;
+		}
+
+		sensor_val *sval = (sensor_val *)reading;
+		sval->integer = (int16_t)power;
+		sval->fraction = (int16_t)((power - sval->integer) * 1000);
+		return SENSOR_READ_4BYTE_ACUR_SUCCESS;
+	}
 	default:
 		LOG_ERR("Invalid mbr type during changing sensor mbr");
 		break;
@@ -1050,103 +1127,629 @@ __weak void plat_sensor_poll_post()
 	return;
 }
 
-void sensor_poll_handler(void *arug0, void *arug1, void *arug2)
+static bool is_sensor_monitor_table_accessible(sensor_monitor_table_info *table_info)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table_info, false);
+
+	if (table_info->access_checker != NULL) {
+		if (table_info->access_checker(table_info->access_checker_arg) != true) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void sensor_poll_single_sensor(uint16_t table_index, sensor_monitor_table_info *table_info,
+				      sensor_cfg *cfg_table, uint8_t sensor_count, sensor_cfg *cfg,
+				      bool check_poll_time)
+{
+	CHECK_NULL_ARG(table_info);
+	CHECK_NULL_ARG(cfg_table);
+	CHECK_NULL_ARG(cfg);
+
+	bool ret = false;
+	int reading = 0;
+	uint8_t sensor_num = cfg->num;
+
+	if (cfg->cache_status == SENSOR_NOT_PRESENT) {
+		return;
+	}
+
+	// Check whether monitoring sensor is enabled
+	if (cfg->is_enable_polling == DISABLE_SENSOR_POLLING) {
+		cfg->cache = SENSOR_FAIL;
+		cfg->cache_status = SENSOR_POLLING_DISABLE;
+		return;
+	}
+
+	if (check_poll_time && (cfg->poll_time != POLL_TIME_DEFAULT)) {
+		if (pal_is_time_to_poll(sensor_num, cfg->poll_time) == false) {
+			return;
+		}
+	}
+
+	if (table_info->pre_monitor != NULL) {
+		ret = table_info->pre_monitor(sensor_num, table_info->pre_post_monitor_arg);
+		if (ret != true) {
+			LOG_ERR("Pre-monitor fail, table index: 0x%x, sensor num: 0x%x", table_index,
+				sensor_num);
+			return;
+		}
+	}
+
+	// check init status then reinit before reading
+	if (cfg->is_initialized != true) {
+		if (cfg->access_checker(sensor_num) == true) { // to skip access check fail sensor
+			common_tbl_sen_reinit(sensor_num);
+		}
+	}
+
+	get_sensor_reading(cfg_table, sensor_count, sensor_num, &reading, GET_FROM_SENSOR);
+
+	if (table_info->post_monitor != NULL) {
+		ret = table_info->post_monitor(sensor_num, table_info->pre_post_monitor_arg);
+		if (ret != true) {
+			LOG_ERR("Post-monitor fail, table index: 0x%x, sensor num: 0x%x", table_index,
+				sensor_num);
+		}
+	}
+}
+
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+/* Whether the sensor port is an I2C/I3C bus the driver talks on directly. For the other types
+ * the port is an ADC channel, PECI address or a bridge and says nothing about bus ownership.
+ */
+static bool is_sensor_on_own_bus(sensor_cfg *cfg)
+{
+	switch (cfg->type) {
+	case sensor_dev_ast_adc:
+	case sensor_dev_intel_peci:
+	case sensor_dev_pch:
+	case sensor_dev_ast_fan:
+	case sensor_dev_pmic:
+	case sensor_dev_apml_mailbox:
+	case sensor_dev_pm8702:
+	case sensor_dev_mpro:
+	case sensor_dev_cx7:
+	case sensor_dev_vistara:
+	case sensor_dev_nv_satmc:
+	case sensor_dev_ast_tach:
+	case sensor_dev_plat_def_sensor:
+		return false;
+	default:
+		return true;
+	}
+}
+
+__weak uint8_t plat_get_sensor_poll_worker(sensor_cfg *cfg, uint8_t worker_id)
+{
+	return worker_id;
+}
+#endif
+
+static bool is_sensor_owned_by_worker(sensor_monitor_table_info *table_info, sensor_cfg *cfg,
+				      uint8_t worker_id)
+{
+	CHECK_NULL_ARG_WITH_RETURN(table_info, false);
+	CHECK_NULL_ARG_WITH_RETURN(cfg, false);
+
+	if (worker_id == SENSOR_POLL_ALL_WORKER) {
+		return true;
+	}
+
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+	uint8_t owner = SENSOR_POLL_SHARED_WORKER;
+
+	// Table monitors may switch shared muxes or power, keep their sensors on one worker
+	if ((table_info->pre_monitor == NULL) && (table_info->post_monitor == NULL) &&
+	    is_sensor_on_own_bus(cfg)) {
+		owner = SENSOR_POLL_WORKER_ID(cfg->port);
+	}
+
+	owner = plat_get_sensor_poll_worker(cfg, owner);
+	if (owner >= SENSOR_POLL_WORKER_NUM) {
+		owner = SENSOR_POLL_SHARED_WORKER;
+	}
+
+	return (owner == worker_id);
+#else
+	return true;
+#endif
+}
+
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+static struct k_thread sensor_poll_worker[SENSOR_POLL_WORKER_NUM];
+K_THREAD_STACK_ARRAY_DEFINE(sensor_poll_worker_stacks, SENSOR_POLL_WORKER_NUM,
+			    SENSOR_POLL_STACK_SIZE);
+static struct k_sem sensor_poll_worker_start[SENSOR_POLL_WORKER_NUM];
+K_SEM_DEFINE(sensor_poll_worker_done, 0, SENSOR_POLL_WORKER_NUM);
+static uint32_t sensor_poll_worker_sweep_ms[SENSOR_POLL_WORKER_NUM];
+static uint32_t sensor_poll_sweep_ms;
+#endif
+
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+/* PMBus page the sensor reads from, platforms decode it from their pre-read hook args */
+__weak uint8_t plat_get_sensor_poll_page(sensor_cfg *cfg)
+{
+	return SENSOR_POLL_PAGE_NONE;
+}
+
+/* Order count configs placed every stride bytes by (port, address, page), table order within
+ * a group. Consecutive reads then stay on one device page, so its PAGE is written once.
+ */
+uint16_t *sensor_build_poll_order(sensor_cfg *first_cfg, size_t stride, uint16_t count)
+{
+	CHECK_NULL_ARG_WITH_RETURN(first_cfg, NULL);
+
+	if (count == 0) {
+		return NULL;
+	}
+
+	uint16_t *order = (uint16_t *)malloc(count * sizeof(uint16_t));
+	uint32_t *keys = (uint32_t *)malloc(count * sizeof(uint32_t));
+	if ((order == NULL) || (keys == NULL)) {
+		LOG_ERR("Failed to allocate sensor poll order");
+		SAFE_FREE(order);
+		SAFE_FREE(keys);
+		return NULL;
+	}
+
+	for (uint16_t i = 0; i < count; i++) {
+		sensor_cfg *cfg = (sensor_cfg *)((uint8_t *)first_cfg + (i * stride));
+		uint32_t key = ((uint32_t)cfg->port << 16) | ((uint32_t)cfg->target_addr << 8) |
+			       plat_get_sensor_poll_page(cfg);
+		uint16_t j = i;
+
+		// Insertion sort keeps equal keys in table order
+		while ((j > 0) && (keys[j - 1] > key)) {
+			keys[j] = keys[j - 1];
+			order[j] = order[j - 1];
+			j--;
+		}
+		keys[j] = key;
+		order[j] = i;
+	}
+
+	SAFE_FREE(keys);
+	return order;
+}
+
+typedef struct _sensor_poll_order_info {
+	sensor_cfg *cfg_table;
+	uint8_t cfg_count;
+	uint16_t *order;
+} sensor_poll_order_info;
+
+static sensor_poll_order_info *sensor_poll_order = NULL;
+static uint16_t sensor_poll_order_count = 0;
+
+/* Built once before polling starts, tables are all registered by then */
+static void sensor_poll_order_init(void)
+{
+	sensor_poll_order = (sensor_poll_order_info *)calloc(sensor_monitor_count,
+							    sizeof(sensor_poll_order_info));
+	if (sensor_poll_order == NULL) {
+		LOG_ERR("Failed to allocate sensor poll order table");
+		return;
+	}
+	sensor_poll_order_count = sensor_monitor_count;
+
+	for (uint16_t table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_poll_order_info *info = &sensor_poll_order[table_index];
+
+		info->cfg_table = sensor_monitor_table[table_index].monitor_sensor_cfg;
+		info->cfg_count = sensor_monitor_table[table_index].cfg_count;
+		if (info->cfg_table != NULL) {
+			info->order = sensor_build_poll_order(info->cfg_table, sizeof(sensor_cfg),
+							      info->cfg_count);
+		}
+	}
+}
+
+static uint8_t get_sensor_poll_index(uint16_t table_index, sensor_cfg *cfg_table,
+				     uint8_t sensor_count, uint8_t poll_index)
+{
+	// Fall back to table order if the table changed after the order was built
+	if ((table_index < sensor_poll_order_count) &&
+	    (sensor_poll_order[table_index].order != NULL) &&
+	    (sensor_poll_order[table_index].cfg_table == cfg_table) &&
+	    (sensor_poll_order[table_index].cfg_count == sensor_count)) {
+		return sensor_poll_order[table_index].order[poll_index];
+	}
+
+	return poll_index;
+}
+#endif
+
+#ifndef ENABLE_SENSOR_DEADLINE_POLL
+/* Poll every sensor owned by worker_id, SENSOR_POLL_ALL_WORKER polls all sensors */
+static void sensor_poll_sweep(uint8_t worker_id)
 {
 	uint16_t table_index = 0;
 	uint8_t sensor_index = 0;
-	uint8_t sensor_num = 0;
-	int sensor_poll_interval_ms = 0;
-	int reading = 0;
-	bool ret = false;
 
-	k_msleep(1000); // delay 1 second to wait for drivers ready before start sensor polling
+	for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_monitor_table_info *table_info = &sensor_monitor_table[table_index];
 
-	pal_set_sensor_poll_interval(&sensor_poll_interval_ms);
+		if (is_sensor_monitor_table_accessible(table_info) != true) {
+			continue;
+		}
 
-	while (1) {
-		for (table_index = 0; table_index < sensor_monitor_count; ++table_index) {
-			sensor_monitor_table_info *table_info = &sensor_monitor_table[table_index];
+		sensor_cfg *cfg_table = table_info->monitor_sensor_cfg;
+		if (cfg_table == NULL) {
+			LOG_ERR("Table index: 0x%x is NULL, skip to monitor sensor table",
+				table_index);
+			continue;
+		}
 
-			if (table_info->access_checker != NULL) {
-				if (table_info->access_checker(table_info->access_checker_arg) !=
-				    true) {
-					continue;
-				}
+		uint8_t sensor_count = table_info->cfg_count;
+		for (sensor_index = 0; sensor_index < sensor_count; ++sensor_index) {
+			if (sensor_poll_enable_flag == false) { /* skip if disable sensor poll */
+				break;
 			}
 
-			sensor_cfg *cfg_table = table_info->monitor_sensor_cfg;
-			if (cfg_table == NULL) {
-				LOG_ERR("Table index: 0x%x is NULL, skip to monitor sensor table",
-					table_index);
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+			uint8_t poll_index = get_sensor_poll_index(table_index, cfg_table,
+								   sensor_count, sensor_index);
+			sensor_cfg *cfg = &cfg_table[poll_index];
+#else
+			sensor_cfg *cfg = &cfg_table[sensor_index];
+#endif
+			if (is_sensor_owned_by_worker(table_info, cfg, worker_id) != true) {
 				continue;
 			}
 
-			uint8_t sensor_count = table_info->cfg_count;
-			for (sensor_index = 0; sensor_index < sensor_count; ++sensor_index) {
-				if (sensor_poll_enable_flag ==
-				    false) { /* skip if disable sensor poll */
-					break;
-				}
-				sensor_cfg *cfg = &cfg_table[sensor_index];
-				sensor_num = cfg->num;
+			sensor_poll_single_sensor(table_index, table_info, cfg_table, sensor_count,
+						  cfg, true);
+		}
 
-				if (cfg->cache_status == SENSOR_NOT_PRESENT) {
-					continue;
-				}
+		k_yield();
+	}
+}
+#else
+typedef struct _sensor_poll_sched_entry {
+	int64_t due_time_ms;
+	uint16_t table_index;
+	uint8_t sensor_index;
+} sensor_poll_sched_entry;
 
-				// Check whether monitoring sensor is enabled
-				if (cfg->is_enable_polling == DISABLE_SENSOR_POLLING) {
-					cfg->cache = SENSOR_FAIL;
-					cfg->cache_status = SENSOR_POLLING_DISABLE;
-					continue;
-				}
+typedef struct _sensor_poll_sched {
+	sensor_poll_sched_entry *heap; // min-heap keyed on due_time_ms
+	uint16_t count;
+	uint16_t built_sensor_total;
+	uint16_t first_round_remain;
+} sensor_poll_sched;
 
-				if (cfg->poll_time != POLL_TIME_DEFAULT) {
-					if (pal_is_time_to_poll(sensor_num, cfg->poll_time) ==
-					    false) {
-						continue;
-					}
-				}
+static uint16_t get_sensor_monitor_total_count(void)
+{
+	uint16_t total = 0;
 
-				if (table_info->pre_monitor != NULL) {
-					ret = table_info->pre_monitor(
-						sensor_num, table_info->pre_post_monitor_arg);
-					if (ret != true) {
-						LOG_ERR("Pre-monitor fail, table index: 0x%x, sensor num: 0x%x",
-							table_index, sensor_num);
-						continue;
-					}
-				}
+	for (uint16_t table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		total += sensor_monitor_table[table_index].cfg_count;
+	}
 
-				// check init status then reinit before reading
-				if (cfg->is_initialized != true) {
-					if (cfg->access_checker(sensor_num) ==
-					    true) { // to skip access check fail sensor
-						common_tbl_sen_reinit(sensor_num);
-					}
-				}
+	return total;
+}
 
-				get_sensor_reading(cfg_table, sensor_count, sensor_num, &reading,
-						   GET_FROM_SENSOR);
+static uint32_t get_sensor_poll_interval_ms(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, sensor_poll_interval_ms);
 
-				if (table_info->post_monitor != NULL) {
-					ret = table_info->post_monitor(
-						sensor_num, table_info->pre_post_monitor_arg);
-					if (ret != true) {
-						LOG_ERR("Post-monitor fail, table index: 0x%x, sensor num: 0x%x",
-							table_index, sensor_num);
-						continue;
-					}
-				}
+	if (cfg->poll_interval_ms != 0) {
+		return cfg->poll_interval_ms;
+	}
+
+	if (cfg->poll_time > POLL_TIME_DEFAULT) {
+		return (uint32_t)(cfg->poll_time * 1000);
+	}
+
+	return sensor_poll_interval_ms;
+}
+
+static void sensor_sched_swap(sensor_poll_sched *sched, uint16_t a, uint16_t b)
+{
+	sensor_poll_sched_entry tmp = sched->heap[a];
+	sched->heap[a] = sched->heap[b];
+	sched->heap[b] = tmp;
+}
+
+static void sensor_sched_sift_up(sensor_poll_sched *sched, uint16_t index)
+{
+	while (index > 0) {
+		uint16_t parent = (index - 1) / 2;
+		if (sched->heap[parent].due_time_ms <= sched->heap[index].due_time_ms) {
+			break;
+		}
+		sensor_sched_swap(sched, parent, index);
+		index = parent;
+	}
+}
+
+static void sensor_sched_sift_down(sensor_poll_sched *sched, uint16_t index)
+{
+	while (1) {
+		uint16_t smallest = index;
+		uint16_t left = (2 * index) + 1;
+		uint16_t right = left + 1;
+
+		if ((left < sched->count) &&
+		    (sched->heap[left].due_time_ms < sched->heap[smallest].due_time_ms)) {
+			smallest = left;
+		}
+		if ((right < sched->count) &&
+		    (sched->heap[right].due_time_ms < sched->heap[smallest].due_time_ms)) {
+			smallest = right;
+		}
+		if (smallest == index) {
+			break;
+		}
+		sensor_sched_swap(sched, smallest, index);
+		index = smallest;
+	}
+}
+
+/* Collect sensors owned by worker_id into the heap, every sensor is due immediately */
+static bool sensor_sched_build(sensor_poll_sched *sched, uint8_t worker_id)
+{
+	CHECK_NULL_ARG_WITH_RETURN(sched, false);
+
+	uint16_t total = get_sensor_monitor_total_count();
+	int64_t now = k_uptime_get();
+
+	SAFE_FREE(sched->heap);
+	sched->count = 0;
+	sched->built_sensor_total = total;
+	sched->first_round_remain = 0;
+
+	if (total == 0) {
+		return true;
+	}
+
+	sched->heap = (sensor_poll_sched_entry *)malloc(total * sizeof(sensor_poll_sched_entry));
+	if (sched->heap == NULL) {
+		LOG_ERR("Fail to allocate memory for sensor poll schedule, worker: 0x%x",
+			worker_id);
+		return false;
+	}
+
+	for (uint16_t table_index = 0; table_index < sensor_monitor_count; ++table_index) {
+		sensor_monitor_table_info *table_info = &sensor_monitor_table[table_index];
+		sensor_cfg *cfg_table = table_info->monitor_sensor_cfg;
+		if (cfg_table == NULL) {
+			continue;
+		}
+
+		for (uint8_t sensor_index = 0; sensor_index < table_info->cfg_count;
+		     ++sensor_index) {
+			if (is_sensor_owned_by_worker(table_info, &cfg_table[sensor_index],
+						      worker_id) != true) {
+				continue;
+			}
+
+			sched->heap[sched->count].due_time_ms = now;
+			sched->heap[sched->count].table_index = table_index;
+			sched->heap[sched->count].sensor_index = sensor_index;
+			sensor_sched_sift_up(sched, sched->count);
+			sched->count++;
+		}
+	}
+
+	sched->first_round_remain = sched->count;
+	return true;
+}
+
+/* Poll the sensor on top of the heap and push it back with its next deadline */
+static void sensor_sched_run_top(sensor_poll_sched *sched, int64_t now)
+{
+	sensor_poll_sched_entry *entry = &sched->heap[0];
+	sensor_monitor_table_info *table_info = &sensor_monitor_table[entry->table_index];
+	sensor_cfg *cfg_table = table_info->monitor_sensor_cfg;
+	uint32_t interval_ms = sensor_poll_interval_ms;
+
+	if ((cfg_table != NULL) && (entry->sensor_index < table_info->cfg_count)) {
+		sensor_cfg *cfg = &cfg_table[entry->sensor_index];
+		interval_ms = get_sensor_poll_interval_ms(cfg);
+
+		if (is_sensor_monitor_table_accessible(table_info) == true) {
+			cfg->poll_lateness_ms = (uint32_t)(now - entry->due_time_ms);
+			if (cfg->poll_lateness_ms > cfg->poll_lateness_max_ms) {
+				cfg->poll_lateness_max_ms = cfg->poll_lateness_ms;
+			}
+
+			sensor_poll_single_sensor(entry->table_index, table_info, cfg_table,
+						  table_info->cfg_count, cfg, false);
+		}
+	}
+
+	if (sched->first_round_remain > 0) {
+		sched->first_round_remain--;
+	}
+
+	// Skip missed deadlines instead of bursting to catch up
+	entry->due_time_ms += interval_ms;
+	now = k_uptime_get();
+	if (entry->due_time_ms <= now) {
+		entry->due_time_ms = now + interval_ms;
+	}
+	sensor_sched_sift_down(sched, 0);
+}
+
+/* Sleep until the earliest sensor deadline, poll it and reschedule, never returns.
+ * worker_id SENSOR_POLL_ALL_WORKER also runs plat_sensor_poll_post every poll interval,
+ * other workers report their first full round through sensor_poll_worker_done.
+ */
+static void sensor_poll_deadline_loop(uint8_t worker_id)
+{
+	sensor_poll_sched sched = { 0 };
+	int64_t now = 0, wake_time = 0;
+	int64_t next_post_time = k_uptime_get() + sensor_poll_interval_ms;
+	bool first_round_done = false;
+
+	while (1) {
+		if (sched.built_sensor_total != get_sensor_monitor_total_count()) {
+			if (sensor_sched_build(&sched, worker_id) != true) {
+				k_msleep(sensor_poll_interval_ms);
+				continue;
 			}
+		}
+
+		// Checked before sleeping so a worker without sensors reports its round at once
+		if ((first_round_done == false) && (sched.first_round_remain == 0)) {
+			first_round_done = true;
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+			if (worker_id != SENSOR_POLL_ALL_WORKER) {
+				k_sem_give(&sensor_poll_worker_done);
+			} else {
+				is_sensor_ready_flag = true;
+			}
+#else
+			is_sensor_ready_flag = true;
+#endif
+		}
+
+		now = k_uptime_get();
+		wake_time = (sched.count != 0) ? sched.heap[0].due_time_ms :
+						 (now + sensor_poll_interval_ms);
+		if ((worker_id == SENSOR_POLL_ALL_WORKER) && (next_post_time < wake_time)) {
+			wake_time = next_post_time;
+		}
+
+		if (wake_time > now) {
+			k_msleep((int32_t)(wake_time - now));
+			now = k_uptime_get();
+		}
+
+		if ((worker_id == SENSOR_POLL_ALL_WORKER) && (now >= next_post_time)) {
+			plat_sensor_poll_post();
+			next_post_time = now + sensor_poll_interval_ms;
+		}
+
+		if ((sched.count == 0) || (sched.heap[0].due_time_ms > now)) {
+			continue;
+		}
 
-			k_yield();
+		if (sensor_poll_enable_flag == false) { /* postpone if disable sensor poll */
+			sched.heap[0].due_time_ms = now + sensor_poll_interval_ms;
+			sensor_sched_sift_down(&sched, 0);
+			continue;
 		}
 
+		sensor_sched_run_top(&sched, now);
+	}
+}
+#endif
+
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+static void sensor_poll_worker_handler(void *arug0, void *arug1, void *arug2)
+{
+	ARG_UNUSED(arug1);
+	ARG_UNUSED(arug2);
+
+	int worker_id = (int)arug0;
+
+#ifdef ENABLE_SENSOR_DEADLINE_POLL
+	sensor_poll_deadline_loop(worker_id);
+#else
+	uint32_t start_time = 0;
+
+	while (1) {
+		k_sem_take(&sensor_poll_worker_start[worker_id], K_FOREVER);
+
+		start_time = k_uptime_get_32();
+		sensor_poll_sweep(worker_id);
+		sensor_poll_worker_sweep_ms[worker_id] = k_uptime_get_32() - start_time;
+
+		k_sem_give(&sensor_poll_worker_done);
+	}
+#endif
+}
+
+static void sensor_poll_worker_init(void)
+{
+	char worker_name[MAX_SENSOR_NAME_LENGTH];
+
+	for (int i = 0; i < SENSOR_POLL_WORKER_NUM; i++) {
+		k_sem_init(&sensor_poll_worker_start[i], 0, 1);
+		k_thread_create(&sensor_poll_worker[i], sensor_poll_worker_stacks[i],
+				K_THREAD_STACK_SIZEOF(sensor_poll_worker_stacks[i]),
+				sensor_poll_worker_handler, (void *)i, NULL, NULL,
+				CONFIG_MAIN_THREAD_PRIORITY, 0, K_NO_WAIT);
+		snprintf(worker_name, sizeof(worker_name), "sensor_poll_%d", i);
+		k_thread_name_set(&sensor_poll_worker[i], worker_name);
+	}
+}
+
+/* Kick every bus worker and wait until all of them finish the current sweep */
+static void sensor_poll_parallel_sweep(void)
+{
+	uint8_t i = 0;
+	uint32_t start_time = k_uptime_get_32();
+
+#ifndef ENABLE_SENSOR_DEADLINE_POLL
+	for (i = 0; i < SENSOR_POLL_WORKER_NUM; i++) {
+		k_sem_give(&sensor_poll_worker_start[i]);
+	}
+#endif
+
+	for (i = 0; i < SENSOR_POLL_WORKER_NUM; i++) {
+		k_sem_take(&sensor_poll_worker_done, K_FOREVER);
+	}
+
+	sensor_poll_sweep_ms = k_uptime_get_32() - start_time;
+	LOG_DBG("Sensor sweep done in %u ms", sensor_poll_sweep_ms);
+}
+
+uint32_t get_sensor_poll_sweep_time_ms(uint8_t worker_id)
+{
+	if (worker_id == SENSOR_POLL_ALL_WORKER) {
+		return sensor_poll_sweep_ms;
+	}
+
+	if (worker_id >= SENSOR_POLL_WORKER_NUM) {
+		return 0;
+	}
+
+	return sensor_poll_worker_sweep_ms[worker_id];
+}
+#endif
+
+void sensor_poll_handler(void *arug0, void *arug1, void *arug2)
+{
+	k_msleep(1000); // delay 1 second to wait for drivers ready before start sensor polling
+
+	pal_set_sensor_poll_interval(&sensor_poll_interval_ms);
+
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+	sensor_poll_order_init();
+#endif
+
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+	sensor_poll_worker_init();
+#endif
+
+#if defined(ENABLE_SENSOR_DEADLINE_POLL) && !defined(ENABLE_SENSOR_PARALLEL_POLL)
+	sensor_poll_deadline_loop(SENSOR_POLL_ALL_WORKER);
+#else
+#ifdef ENABLE_SENSOR_DEADLINE_POLL
+	/* Workers run their own deadline schedules, wait for their first full round only */
+	sensor_poll_parallel_sweep();
+#endif
+
+	while (1) {
+#ifndef ENABLE_SENSOR_DEADLINE_POLL
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+		sensor_poll_parallel_sweep();
+#else
+		sensor_poll_sweep(SENSOR_POLL_ALL_WORKER);
+#endif
+#endif
+
 		is_sensor_ready_flag = true;
 		plat_sensor_poll_post();
 		k_msleep(sensor_poll_interval_ms);
 	}
+#endif
 }
 
 __weak bool pal_is_time_to_poll(uint8_t sensor_num, int poll_time)
@@ -1341,6 +1944,9 @@ static inline bool init_drive_type(sensor_cfg *p, uint16_t current_drive)
 		}
 	}
 
+	// A device being (re)initialized may have restarted its energy counters
+	sensor_energy_reset(p);
+
 	ret = sensor_drive_tbl[current_drive].init(p);
 	if (ret != SENSOR_INIT_SUCCESS) {
 		LOG_ERR("Sensor num %d initial fail, ret %d", p->num, ret);
@@ -1368,6 +1974,11 @@ uint8_t common_tbl_sen_reinit(uint8_t sen_num)
 		return SENSOR_NOT_FOUND;
 	}
 
+#ifdef ENABLE_PMBUS_REG_CACHE
+	// Reinit usually follows a VR update, static registers have to be read again
+	pmbus_reg_cache_invalidate(cfg->port, cfg->target_addr);
+#endif
+
 	for (uint8_t i = 0; i < ARRAY_SIZE(sensor_drive_tbl); i++) {
 		if (cfg->type != sensor_drive_tbl[i].dev)
 			continue;
@@ -1491,6 +2102,7 @@ bool sensor_init(void)
 
 	map_sensor_num_to_sdr_cfg();
 	init_sensor_monitor_table();
+	init_sensor_monitor_index_map();
 
 	/* register read api of sensor_config */
 	drive_init();
@@ -1569,6 +2181,7 @@ bool init_drive_type_delayed(sensor_cfg *cfg)
 
 	for (index = 0; index < max_drive_num; index++) {
 		if (cfg->type == sensor_drive_tbl[index].dev) {
+			sensor_energy_reset(cfg);
 			ret = sensor_drive_tbl[index].init(cfg);
 			if (ret != SENSOR_INIT_SUCCESS) {
 				return false;
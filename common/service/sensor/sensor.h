@@ -34,6 +34,7 @@
 
 #define GET_FROM_CACHE 0x00
 #define GET_FROM_SENSOR 0x01
+#define GET_FROM_ENERGY_ACCUM 0x02
 
 #define SENSOR_NULL 0xFF
 #define SENSOR_FAIL 0xFF
@@ -47,6 +48,25 @@
 
 #define POLL_TIME_DEFAULT 1
 
+/* Sensors are split into bus workers by port when ENABLE_SENSOR_PARALLEL_POLL is defined,
+ * all sensors on the same I2C/I3C port are always polled by the same worker. Sensors of other
+ * types (ADC, PECI, tach, IPMB and MCTP bridged) and every sensor of a table with pre/post
+ * monitors stay on SENSOR_POLL_SHARED_WORKER, so those drivers and table monitors never run
+ * concurrently. Sensor pre/post read hooks and driver init/read functions of sensors on other
+ * ports do run concurrently and must be reentrant; a platform whose hooks share state across
+ * ports, e.g. one mux switched from several buses, keeps them together through
+ * plat_get_sensor_poll_worker().
+ */
+#ifndef SENSOR_POLL_WORKER_NUM
+#define SENSOR_POLL_WORKER_NUM 4
+#endif
+#define SENSOR_POLL_SHARED_WORKER 0
+#define SENSOR_POLL_ALL_WORKER 0xFF
+#define SENSOR_POLL_WORKER_ID(port) ((port) % SENSOR_POLL_WORKER_NUM)
+
+/* With ENABLE_SENSOR_POLL_PAGE_GROUPING sensors are polled grouped by (port, address, page) */
+#define SENSOR_POLL_PAGE_NONE 0xFF
+
 enum LTC4282_OFFSET {
 	LTC4282_ILIM_ADJUST_OFFSET = 0x11,
 	LTC4282_VSENSE_OFFSET = 0x40,
@@ -281,6 +301,7 @@ typedef struct _sensor_cfg_ {
 	bool (*post_sensor_read_hook)(struct _sensor_cfg_ *, void *, int *);
 	void *post_sensor_read_args;
 	void *init_args;
+	uint32_t poll_interval_ms; // used by deadline poll, 0: follow poll_time
 
 	/* if there is new parameter should be added, please add on above */
 	void *priv_data;
@@ -288,6 +309,10 @@ typedef struct _sensor_cfg_ {
 	uint8_t (*init)(uint8_t, int *);
 	uint8_t (*read)(struct _sensor_cfg_ *, int *);
 	bool is_initialized;
+#ifdef ENABLE_SENSOR_DEADLINE_POLL
+	uint32_t poll_lateness_ms; // last read time minus its deadline
+	uint32_t poll_lateness_max_ms;
+#endif
 } sensor_cfg;
 
 typedef struct _sensor_monitor_table_info {
@@ -648,13 +673,6 @@ typedef struct _adm1272_init_arg {
 	bool is_init;
 	bool is_need_set_pwr_cfg;
 	float r_sense_mohm;
-
-#ifdef MORE_THAN_ONE_ADM1272
-	bool is_record_ein;
-	uint32_t last_energy;
-	uint32_t last_rollover;
-	uint32_t last_sample;
-#endif
 } adm1272_init_arg;
 
 typedef struct _sq52205_init_arg_ {
@@ -865,6 +883,15 @@ sensor_cfg *find_sensor_cfg_via_sensor_num(sensor_cfg *cfg_table, uint8_t cfg_co
 bool get_sensor_init_done_flag();
 sensor_cfg *get_common_sensor_cfg_info(uint8_t sensor_num);
 uint8_t common_tbl_sen_reinit(uint8_t sen_num);
+void init_sensor_monitor_index_map(void);
 void plat_sensor_poll_post();
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+uint32_t get_sensor_poll_sweep_time_ms(uint8_t worker_id);
+uint8_t plat_get_sensor_poll_worker(sensor_cfg *cfg, uint8_t worker_id);
+#endif
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+uint8_t plat_get_sensor_poll_page(sensor_cfg *cfg);
+uint16_t *sensor_build_poll_order(sensor_cfg *first_cfg, size_t stride, uint16_t count);
+#endif
 
 #endif
@@ -0,0 +1,355 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <zephyr.h>
+#include <stdlib.h>
+#include <string.h>
+#include <logging/log.h>
+#include "libutil.h"
+#include "sensor_energy.h"
+
+LOG_MODULE_REGISTER(sensor_energy);
+
+#ifndef SENSOR_ENERGY_TABLE_SIZE
+#define SENSOR_ENERGY_TABLE_SIZE SENSOR_ENERGY_TABLE_SIZE_DEFAULT
+#endif
+
+typedef struct _sensor_energy_point {
+	int64_t uptime_ms;
+	double energy;
+} sensor_energy_point;
+
+/* Power integrated over BIC uptime, in the sensor's power unit times seconds */
+typedef struct _sensor_energy_accum {
+	int64_t first_ms;
+	int64_t prev_ms;
+	int64_t last_ms;
+	double last_power;
+	double energy;
+
+	sensor_energy_point history[SENSOR_ENERGY_HISTORY_LEN];
+	uint8_t history_head;
+	uint8_t history_count;
+} sensor_energy_accum;
+
+/* Raw energy/sample counters of the previous poll */
+typedef struct _sensor_energy_counter {
+	bool valid;
+	uint32_t last_sample;
+	uint64_t last_energy;
+} sensor_energy_counter;
+
+/* Energy state of one sensor. Entries are keyed by sensor config entry, since sensor numbers
+ * repeat across sensor monitor tables.
+ */
+typedef struct _sensor_energy_entry {
+	const sensor_cfg *cfg;
+	sensor_energy_counter counter;
+	sensor_energy_accum *accum; // allocated on the first accumulate of this sensor
+} sensor_energy_entry;
+
+/* Only sensors that report energy get an entry, so the table stays small */
+static sensor_energy_entry *energy_table = NULL;
+static uint16_t energy_table_size = 0;
+static uint16_t energy_table_count = 0;
+static struct k_spinlock energy_accum_lock;
+
+static uint64_t sensor_energy_counter_diff(uint64_t current, uint64_t previous, uint64_t wrap)
+{
+	if ((current >= previous) || (wrap == 0)) {
+		return current - previous;
+	}
+
+	return current + wrap - previous;
+}
+
+static void sensor_energy_push_history(sensor_energy_accum *accum)
+{
+	if (accum->history_count != 0) {
+		uint8_t newest = (accum->history_head + SENSOR_ENERGY_HISTORY_LEN - 1) %
+				 SENSOR_ENERGY_HISTORY_LEN;
+		if ((accum->last_ms - accum->history[newest].uptime_ms) <
+		    SENSOR_ENERGY_HISTORY_INTERVAL_MS) {
+			return;
+		}
+	}
+
+	accum->history[accum->history_head].uptime_ms = accum->last_ms;
+	accum->history[accum->history_head].energy = accum->energy;
+	accum->history_head = (accum->history_head + 1) % SENSOR_ENERGY_HISTORY_LEN;
+	if (accum->history_count < SENSOR_ENERGY_HISTORY_LEN) {
+		accum->history_count++;
+	}
+}
+
+static sensor_energy_entry *sensor_energy_find(const sensor_cfg *cfg)
+{
+	for (int i = 0; i < energy_table_count; i++) {
+		if (energy_table[i].cfg == cfg) {
+			return &energy_table[i];
+		}
+	}
+
+	return NULL;
+}
+
+/* Make room for one more entry, the allocation happens outside the spinlock */
+static void sensor_energy_table_grow(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&energy_accum_lock);
+	uint16_t old_size = energy_table_size;
+	k_spin_unlock(&energy_accum_lock, key);
+
+	if (old_size > (UINT16_MAX / 2)) {
+		return;
+	}
+
+	uint16_t new_size = (old_size == 0) ? SENSOR_ENERGY_TABLE_SIZE : (old_size * 2);
+	sensor_energy_entry *new_table = malloc(new_size * sizeof(sensor_energy_entry));
+	if (new_table == NULL) {
+		return;
+	}
+
+	sensor_energy_entry *old_table = NULL;
+	key = k_spin_lock(&energy_accum_lock);
+	if (energy_table_size == old_size) {
+		memcpy(new_table, energy_table, energy_table_count * sizeof(*new_table));
+		old_table = energy_table;
+		energy_table = new_table;
+		energy_table_size = new_size;
+		new_table = NULL;
+	}
+	k_spin_unlock(&energy_accum_lock, key);
+
+	// Either the replaced table or ours when another thread grew it first
+	SAFE_FREE(old_table);
+	SAFE_FREE(new_table);
+}
+
+/* Find or add the entry of cfg. On success energy_accum_lock is held and the caller releases it
+ * with key, entries move when the table grows so the pointer is only valid under the lock.
+ */
+static sensor_energy_entry *sensor_energy_lock_entry(const sensor_cfg *cfg, k_spinlock_key_t *key)
+{
+	for (int attempt = 0; attempt < 2; attempt++) {
+		*key = k_spin_lock(&energy_accum_lock);
+
+		sensor_energy_entry *entry = sensor_energy_find(cfg);
+		if ((entry == NULL) && (energy_table_count < energy_table_size)) {
+			entry = &energy_table[energy_table_count++];
+			memset(entry, 0, sizeof(*entry));
+			entry->cfg = cfg;
+		}
+
+		if (entry != NULL) {
+			return entry;
+		}
+
+		k_spin_unlock(&energy_accum_lock, *key);
+		sensor_energy_table_grow();
+	}
+
+	LOG_DBG("No memory to track energy of sensor 0x%x", cfg->num);
+	return NULL;
+}
+
+/* Store the raw energy and sample counters of this poll and return how far both moved since the
+ * previous one, wrap-around included. Returns -1 until two snapshots exist or when no sample
+ * elapsed, the caller then has nothing to report yet. The counters never depend on the
+ * accumulator being available.
+ */
+int sensor_energy_update_counter(sensor_cfg *cfg, uint64_t energy, uint64_t energy_wrap,
+				 uint32_t sample, uint32_t sample_wrap, uint64_t *energy_diff,
+				 uint32_t *sample_diff)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, -1);
+	CHECK_NULL_ARG_WITH_RETURN(energy_diff, -1);
+	CHECK_NULL_ARG_WITH_RETURN(sample_diff, -1);
+
+	int ret = -1;
+	k_spinlock_key_t key;
+	sensor_energy_entry *entry = sensor_energy_lock_entry(cfg, &key);
+	if (entry == NULL) {
+		return -1;
+	}
+
+	sensor_energy_counter *counter = &entry->counter;
+	if (counter->valid) {
+		*energy_diff =
+			sensor_energy_counter_diff(energy, counter->last_energy, energy_wrap);
+		*sample_diff = (uint32_t)sensor_energy_counter_diff(sample, counter->last_sample,
+								    sample_wrap);
+		ret = (*sample_diff == 0) ? -1 : 0;
+	}
+
+	counter->last_energy = energy;
+	counter->last_sample = sample;
+	counter->valid = true;
+
+	k_spin_unlock(&energy_accum_lock, key);
+	return ret;
+}
+
+/* Integrate the average power of the interval that just ended. The accumulator is allocated on
+ * the first call, if that fails the sensor keeps reporting its interval average only.
+ */
+void sensor_energy_accumulate(sensor_cfg *cfg, double power)
+{
+	CHECK_NULL_ARG(cfg);
+
+	int64_t now = k_uptime_get();
+	sensor_energy_accum *new_accum = NULL;
+	k_spinlock_key_t key;
+	sensor_energy_entry *entry = sensor_energy_lock_entry(cfg, &key);
+	if (entry == NULL) {
+		return;
+	}
+
+	if (entry->accum == NULL) {
+		k_spin_unlock(&energy_accum_lock, key);
+
+		new_accum = malloc(sizeof(sensor_energy_accum));
+		if (new_accum == NULL) {
+			LOG_DBG("No memory for energy accumulator of sensor 0x%x", cfg->num);
+			return;
+		}
+		memset(new_accum, 0, sizeof(*new_accum));
+		new_accum->first_ms = now;
+		new_accum->prev_ms = now;
+		new_accum->last_ms = now;
+		new_accum->last_power = power;
+		sensor_energy_push_history(new_accum);
+
+		entry = sensor_energy_lock_entry(cfg, &key);
+		if (entry == NULL) {
+			SAFE_FREE(new_accum);
+			return;
+		}
+
+		if (entry->accum == NULL) {
+			// First point, integration starts with the next interval
+			entry->accum = new_accum;
+			k_spin_unlock(&energy_accum_lock, key);
+			return;
+		}
+	}
+
+	sensor_energy_accum *accum = entry->accum;
+	accum->energy += power * (double)(now - accum->last_ms) / 1000;
+	accum->prev_ms = accum->last_ms;
+	accum->last_ms = now;
+	accum->last_power = power;
+	sensor_energy_push_history(accum);
+
+	k_spin_unlock(&energy_accum_lock, key);
+
+	// Another poll of this sensor installed its accumulator first
+	SAFE_FREE(new_accum);
+}
+
+/* Average power over the last window_ms, window_ms 0 means since the first poll.
+ * span_ms reports the window actually covered, bounded by the history depth.
+ */
+int sensor_energy_get_average_power(sensor_cfg *cfg, uint32_t window_ms, double *power,
+				    uint32_t *span_ms)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, -1);
+	CHECK_NULL_ARG_WITH_RETURN(power, -1);
+
+	int64_t start_ms = 0;
+	double start_energy = 0;
+	k_spinlock_key_t key = k_spin_lock(&energy_accum_lock);
+
+	sensor_energy_entry *entry = sensor_energy_find(cfg);
+	if ((entry == NULL) || (entry->accum == NULL)) {
+		k_spin_unlock(&energy_accum_lock, key);
+		return -1;
+	}
+
+	sensor_energy_accum *accum = entry->accum;
+
+	if (window_ms == 0) {
+		start_ms = accum->first_ms;
+		start_energy = 0;
+	} else if (window_ms <= (accum->last_ms - accum->prev_ms)) {
+		start_ms = accum->last_ms;
+	} else {
+		// Newest history point at or before the window start, else the oldest one
+		int64_t target_ms = accum->last_ms - window_ms;
+		uint8_t oldest = (accum->history_head + SENSOR_ENERGY_HISTORY_LEN -
+				  accum->history_count) %
+				 SENSOR_ENERGY_HISTORY_LEN;
+
+		start_ms = accum->history[oldest].uptime_ms;
+		start_energy = accum->history[oldest].energy;
+		for (uint8_t i = 1; i < accum->history_count; i++) {
+			uint8_t index = (oldest + i) % SENSOR_ENERGY_HISTORY_LEN;
+			if (accum->history[index].uptime_ms > target_ms) {
+				break;
+			}
+			start_ms = accum->history[index].uptime_ms;
+			start_energy = accum->history[index].energy;
+		}
+	}
+
+	if (start_ms >= accum->last_ms) {
+		// Shorter than one poll interval, the last interval average is the best answer
+		*power = accum->last_power;
+		if (span_ms != NULL) {
+			*span_ms = (uint32_t)(accum->last_ms - accum->prev_ms);
+		}
+	} else {
+		*power = (accum->energy - start_energy) * 1000 / (double)(accum->last_ms - start_ms);
+		if (span_ms != NULL) {
+			*span_ms = (uint32_t)(accum->last_ms - start_ms);
+		}
+	}
+
+	k_spin_unlock(&energy_accum_lock, key);
+	return 0;
+}
+
+/* Energy integrated since the first poll, in the sensor's power unit times seconds */
+int sensor_energy_get_total(sensor_cfg *cfg, double *energy)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, -1);
+	CHECK_NULL_ARG_WITH_RETURN(energy, -1);
+
+	int ret = -1;
+	k_spinlock_key_t key = k_spin_lock(&energy_accum_lock);
+
+	sensor_energy_entry *entry = sensor_energy_find(cfg);
+	if ((entry != NULL) && (entry->accum != NULL)) {
+		*energy = entry->accum->energy;
+		ret = 0;
+	}
+
+	k_spin_unlock(&energy_accum_lock, key);
+	return ret;
+}
+
+/* Forget the raw counters, sensor init calls it since the device counters may restart */
+void sensor_energy_reset(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG(cfg);
+
+	k_spinlock_key_t key = k_spin_lock(&energy_accum_lock);
+	sensor_energy_entry *entry = sensor_energy_find(cfg);
+	if (entry != NULL) {
+		entry->counter.valid = false;
+	}
+	k_spin_unlock(&energy_accum_lock, key);
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SENSOR_ENERGY_H
+#define SENSOR_ENERGY_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "sensor.h"
+
+/* History points kept per sensor, spaced at least SENSOR_ENERGY_HISTORY_INTERVAL_MS apart.
+ * The longest window that can be answered exactly is LEN * INTERVAL.
+ */
+#define SENSOR_ENERGY_HISTORY_LEN 16
+#define SENSOR_ENERGY_HISTORY_INTERVAL_MS 5000
+/* Initial number of energy sensors tracked, the table doubles when it fills up */
+#define SENSOR_ENERGY_TABLE_SIZE_DEFAULT 8
+/* Window used by the GET_FROM_ENERGY_ACCUM sensor read mode */
+#define SENSOR_ENERGY_READ_WINDOW_MS_DEFAULT 60000
+
+/* Counter wrap value for a plain 32-bit counter, 0 means the counter never wraps below 2^64 */
+#define SENSOR_ENERGY_WRAP_32BIT ((uint64_t)1 << 32)
+
+int sensor_energy_update_counter(sensor_cfg *cfg, uint64_t energy, uint64_t energy_wrap,
+				 uint32_t sample, uint32_t sample_wrap, uint64_t *energy_diff,
+				 uint32_t *sample_diff);
+void sensor_energy_accumulate(sensor_cfg *cfg, double power);
+int sensor_energy_get_average_power(sensor_cfg *cfg, uint32_t window_ms, double *power,
+				    uint32_t *span_ms);
+int sensor_energy_get_total(sensor_cfg *cfg, double *energy);
+void sensor_energy_reset(sensor_cfg *cfg);
+
+#endif
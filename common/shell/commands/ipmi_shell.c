@@ -119,3 +119,95 @@ void cmd_ipmi_list(const struct shell *shell, size_t argc, char **argv)
 		shell,
 		"------------------------------------------------------------------------------");
 }
+
+void cmd_ipmb_pool_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc != 1) {
+		shell_warn(shell, "Help: platform ipmi ipmb_pool");
+		return;
+	}
+
+	ipmb_pool_stat stat;
+	uint8_t pool_id = 0;
+
+	shell_print(shell, "%-12s %-6s %-6s %-6s %-6s %s", "pool", "size", "total", "used", "max",
+		    "fail");
+	for (pool_id = 0; ipmb_get_pool_stat(pool_id, &stat); pool_id++) {
+		char total[8] = "heap";
+		if (stat.block_num != 0) {
+			snprintf(total, sizeof(total), "%d", stat.block_num);
+		}
+		shell_print(shell, "%-12s %-6d %-6s %-6d %-6d %d", stat.name, stat.block_size,
+			    total, stat.used, stat.max_used, stat.alloc_fail);
+	}
+
+	if (pool_id == 0) {
+		shell_print(shell, "IPMB is not enabled");
+	}
+}
+
+void cmd_ipmb_rx_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc != 1) {
+		shell_warn(shell, "Help: platform ipmi ipmb_rx");
+		return;
+	}
+
+	ipmb_rx_stat stat;
+	uint8_t index = 0;
+
+	if (IPMB_config_table == NULL) {
+		shell_print(shell, "IPMB is not enabled");
+		return;
+	}
+
+	shell_print(shell, "%-6s %-6s %-10s %s", "index", "bus", "wakeup", "frame");
+	for (index = 0; ipmb_get_rx_stat(index, &stat); index++) {
+		if (IPMB_config_table[index].index == RESERVED_IDX) {
+			break;
+		}
+		shell_print(shell, "%-6d %-6d %-10u %u", index, IPMB_config_table[index].bus,
+			    stat.wakeup_cnt, stat.frame_cnt);
+	}
+
+	if (index == 0) {
+		shell_print(shell, "IPMB is not enabled");
+	}
+}
+
+void cmd_ipmi_lane_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc != 1) {
+		shell_warn(shell, "Help: platform ipmi lane");
+		return;
+	}
+
+	ipmi_lane_stat stat;
+
+	shell_print(shell, "%-6s %-8s %-8s %-6s %-6s %-6s %-10s %s", "lane", "handled", "timeout",
+		    "busy", "depth", "max", "last(ms)", "max(ms)");
+	for (uint8_t lane_id = 0; ipmi_get_lane_stat(lane_id, &stat); lane_id++) {
+		shell_print(shell, "%-6s %-8u %-8u %-6u %-6d %-6d %-10u %u", stat.name,
+			    stat.handled, stat.timeout, stat.busy, stat.queue_depth, stat.queue_max,
+			    stat.latency_last_ms, stat.latency_max_ms);
+	}
+}
+
+void cmd_ipmi_msgq_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc != 1) {
+		shell_warn(shell, "Help: platform ipmi msgq");
+		return;
+	}
+
+	ipmi_msgq_stat stat;
+	if (ipmi_get_msgq_stat(&stat) == false) {
+		shell_error(shell, "Failed to get ipmi msgq counters");
+		return;
+	}
+
+	shell_print(shell, "reject (queue full)   : %u", stat.reject_full);
+	shell_print(shell, "reject (source limit) : %u", stat.reject_source);
+	shell_print(shell, "drop (timeout)        : %u", stat.drop);
+	shell_print(shell, "queue depth/max       : %d/%d", stat.queue_depth, stat.queue_max);
+}
@@ -22,9 +22,18 @@
 
 void cmd_ipmi_list(const struct shell *shell, size_t argc, char **argv);
 void cmd_ipmi_raw(const struct shell *shell, size_t argc, char **argv);
+void cmd_ipmb_pool_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_ipmb_rx_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_ipmi_lane_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_ipmi_msgq_stat(const struct shell *shell, size_t argc, char **argv);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	sub_ipmi_cmds, SHELL_CMD(scan, NULL, "Scanning all supported commands", cmd_ipmi_list),
-	SHELL_CMD(raw, NULL, "Send raw command", cmd_ipmi_raw), SHELL_SUBCMD_SET_END);
+	SHELL_CMD(raw, NULL, "Send raw command", cmd_ipmi_raw),
+	SHELL_CMD(ipmb_pool, NULL, "Get IPMB memory pool usage", cmd_ipmb_pool_stat),
+	SHELL_CMD(ipmb_rx, NULL, "Get IPMB rx task wakeup/frame counters", cmd_ipmb_rx_stat),
+	SHELL_CMD(lane, NULL, "Get IPMI handler lane counters", cmd_ipmi_lane_stat),
+	SHELL_CMD(msgq, NULL, "Get IPMI message queue back-pressure counters", cmd_ipmi_msgq_stat),
+	SHELL_SUBCMD_SET_END);
 
 #endif
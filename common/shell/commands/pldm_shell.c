@@ -80,3 +80,41 @@ void cmd_pldm_send_req(const struct shell *shell, size_t argc, char **argv)
 exit:
 	SAFE_FREE(pmsg.buf);
 }
+
+void cmd_mctp_rx_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc != 2) {
+		shell_warn(shell, "Help: platform pldm mctp_rx <mctp_dest_eid>");
+		return;
+	}
+
+	uint8_t mctp_dest_eid = strtol(argv[1], NULL, 16);
+	mctp_ext_params ext_params = { 0 };
+	mctp *mctp_inst = NULL;
+	if (get_mctp_info_by_eid(mctp_dest_eid, &mctp_inst, &ext_params) == false) {
+		shell_error(shell, "Failed to get mctp info by eid 0x%x", mctp_dest_eid);
+		return;
+	}
+
+	shell_print(shell, "* mctp: 0x%x eid: 0x%x wakeup: %u frame: %u", mctp_inst, mctp_dest_eid,
+		    mctp_inst->rx_wakeup_cnt, mctp_inst->rx_frame_cnt);
+}
+
+void cmd_pldm_event_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (argc != 1) {
+		shell_warn(shell, "Help: platform pldm event");
+		return;
+	}
+
+	struct pldm_event_queue_stat stat;
+	if (pldm_get_event_queue_stat(&stat) == false) {
+		shell_error(shell, "Failed to get pldm event queue counters");
+		return;
+	}
+
+	shell_print(shell, "queued: %u sent: %u failed: %u dropped: %u coalesced: %u", stat.queued,
+		    stat.sent, stat.failed, stat.dropped, stat.coalesced);
+	shell_print(shell, "depth: %d max: %d latency last: %u ms max: %u ms", stat.depth,
+		    stat.depth_max, stat.latency_last_ms, stat.latency_max_ms);
+}
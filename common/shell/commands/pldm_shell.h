@@ -20,10 +20,16 @@
 #include <shell/shell.h>
 
 void cmd_pldm_send_req(const struct shell *shell, size_t argc, char **argv);
+void cmd_mctp_rx_stat(const struct shell *shell, size_t argc, char **argv);
+void cmd_pldm_event_stat(const struct shell *shell, size_t argc, char **argv);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(sub_pldm_cmds,
 			       SHELL_CMD(sendreq, NULL, "Send out PLDM request.",
 					 cmd_pldm_send_req),
+			       SHELL_CMD(mctp_rx, NULL, "Get MCTP rx task wakeup/frame counters.",
+					 cmd_mctp_rx_stat),
+			       SHELL_CMD(event, NULL, "Get PLDM event queue counters.",
+					 cmd_pldm_event_stat),
 			       SHELL_SUBCMD_SET_END);
 
 #endif
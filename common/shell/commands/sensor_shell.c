@@ -633,3 +633,46 @@ void cmd_control_sensor_polling(const struct shell *shell, size_t argc, char **a
 		    ((operation == DISABLE_SENSOR_POLLING) ? "disable" : "enable"));
 	return;
 }
+
+void cmd_sensor_poll_stat(const struct shell *shell, size_t argc, char **argv)
+{
+	if (shell == NULL) {
+		return;
+	}
+
+	if (argc != 1) {
+		shell_warn(shell, "Help: platform sensor poll_stat");
+		return;
+	}
+
+#ifdef ENABLE_SENSOR_PARALLEL_POLL
+	shell_print(shell, "Sweep time: %u ms",
+		    get_sensor_poll_sweep_time_ms(SENSOR_POLL_ALL_WORKER));
+	for (uint8_t worker_id = 0; worker_id < SENSOR_POLL_WORKER_NUM; ++worker_id) {
+		shell_print(shell, "  worker %d: %u ms", worker_id,
+			    get_sensor_poll_sweep_time_ms(worker_id));
+	}
+#endif
+
+#ifdef ENABLE_SENSOR_DEADLINE_POLL
+	uint16_t table_idx = 0;
+	uint8_t sensor_idx = 0;
+
+	for (table_idx = 0; table_idx < sensor_monitor_count; ++table_idx) {
+		sensor_cfg *cfg_table = sensor_monitor_table[table_idx].monitor_sensor_cfg;
+		if (cfg_table == NULL) {
+			continue;
+		}
+
+		for (sensor_idx = 0; sensor_idx < sensor_monitor_table[table_idx].cfg_count;
+		     ++sensor_idx) {
+			sensor_cfg *cfg = &cfg_table[sensor_idx];
+			shell_print(
+				shell,
+				"[0x%-2x] table 0x%-2x | port 0x%-2x | interval %-6u ms | late %-6u ms | max late %-6u ms",
+				cfg->num, table_idx, cfg->port, cfg->poll_interval_ms,
+				cfg->poll_lateness_ms, cfg->poll_lateness_max_ms);
+		}
+	}
+#endif
+}
@@ -30,6 +30,7 @@ void cmd_sensor_cfg_list_all_sensor(const struct shell *shell, size_t argc, char
 void cmd_sensor_cfg_get_table_all_sensor(const struct shell *shell, size_t argc, char **argv);
 void cmd_sensor_cfg_get_table_single_sensor(const struct shell *shell, size_t argc, char **argv);
 void cmd_control_sensor_polling(const struct shell *shell, size_t argc, char **argv);
+void cmd_sensor_poll_stat(const struct shell *shell, size_t argc, char **argv);
 
 SHELL_STATIC_SUBCMD_SET_CREATE(
 	sub_sensor_cmds,
@@ -41,6 +42,8 @@ SHELL_STATIC_SUBCMD_SET_CREATE(
 		  cmd_sensor_cfg_get_table_single_sensor),
 	SHELL_CMD(control_sensor_polling, NULL, "Enable/Disable sensor polling",
 		  cmd_control_sensor_polling),
+	SHELL_CMD(poll_stat, NULL, "Get sensor poll sweep time and deadline lateness",
+		  cmd_sensor_poll_stat),
 	SHELL_SUBCMD_SET_END);
 
 #endif
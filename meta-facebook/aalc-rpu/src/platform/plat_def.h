@@ -20,7 +20,6 @@
 #define BMC_USB_PORT "CDC_ACM_0"
 
 #define ADC_CALIBRATION 1
-#define MORE_THAN_ONE_ADM1272
 #define ENABLE_PLAT_DEF_SENSOR
 #define BIC_UPDATE_MAX_OFFSET 0x60000
 
@@ -60,190 +60,114 @@ adm1272_init_arg adm1272_init_args[] = {
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,      
 	},
 	// fan board 2
 	[1] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 3
 	[2] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 4
 	[3] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 5
 	[4] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 6
 	[5] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 7
 	[6] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 8
 	[7] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 9
 	[8] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 10
 	[9] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 11
 	[10] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 12
 	[11] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 13
 	[12] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// fan board 14
 	[13] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// pump board 1
 	[14] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// pump board 2
 	[15] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// pump board 3
 	[16] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 1,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// bridge board 
 	[17] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 3,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	// backplane board 
 	[18] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 0.3,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 };
 
@@ -21,7 +21,6 @@
 #define KEYWORD_CPLD_LATTICE "LCMXO3-4300C"
 #define BIC_FW_VERSION_ADD_FRU_NAME
 #define FW_UPDATE_RETRY_MAX_COUNT 4
-#define MORE_THAN_ONE_ADM1272
 
 #define DISABLE_ISL69259
 #define DISABLE_MP5990
@@ -71,19 +71,11 @@ adm1272_init_arg adm1272_init_args[] = {
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 0.3,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 	[1] = { .is_init = false,
 		.is_need_set_pwr_cfg = true,
 		.pwr_monitor_cfg.value = 0x3F3F,
 		.r_sense_mohm = 0.3,
-		.is_record_ein = false,
-		.last_energy = 0,
-		.last_rollover = 0,
-		.last_sample = 0,
 	},
 };
 
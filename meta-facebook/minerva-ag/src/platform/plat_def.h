@@ -51,6 +51,10 @@
 #define ENABLE_BMR316
 #define ENABLE_S54SS4P180PMDCF
 
+#define ENABLE_PMBUS_REG_CACHE
+#define ENABLE_PMBUS_PAGE_CACHE
+#define ENABLE_SENSOR_POLL_PAGE_GROUPING
+
 #define DISABLE_AST_ADC
 #define DISABLE_NVME
 #define DISABLE_MP5990
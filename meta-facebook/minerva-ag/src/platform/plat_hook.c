@@ -37,6 +37,7 @@
 #include "plat_pldm_sensor.h"
 #include "plat_class.h"
 #include "pmbus.h"
+#include "util_pmbus.h"
 #include "plat_i2c_target.h"
 #include "pldm_sensor.h"
 #include "bmr313.h"
@@ -534,8 +535,6 @@ bool pre_vr_read(sensor_cfg *cfg, void *args)
 	CHECK_NULL_ARG_WITH_RETURN(args, false);
 
 	vr_pre_proc_arg *pre_proc_args = (vr_pre_proc_arg *)args;
-	uint8_t retry = 5;
-	I2C_MSG msg;
 
 	/* mutex lock */
 	if (pre_proc_args->mutex) {
@@ -546,13 +545,8 @@ bool pre_vr_read(sensor_cfg *cfg, void *args)
 		}
 	}
 
-	/* set page */
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 2;
-	msg.data[0] = 0x00;
-	msg.data[1] = pre_proc_args->vr_page;
-	if (i2c_master_write(&msg, retry)) {
+	/* set page, skipped when the VR is already on it */
+	if (pmbus_select_page(cfg->port, cfg->target_addr, pre_proc_args->vr_page)) {
 		k_mutex_unlock(pre_proc_args->mutex);
 		LOG_ERR("pre_vr_read, set page fail");
 		return false;
@@ -560,6 +554,19 @@ bool pre_vr_read(sensor_cfg *cfg, void *args)
 	return true;
 }
 
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+uint8_t plat_get_sensor_poll_page(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, SENSOR_POLL_PAGE_NONE);
+
+	if ((cfg->pre_sensor_read_hook != pre_vr_read) || (cfg->pre_sensor_read_args == NULL)) {
+		return SENSOR_POLL_PAGE_NONE;
+	}
+
+	return ((vr_pre_proc_arg *)cfg->pre_sensor_read_args)->vr_page;
+}
+#endif
+
 bool post_vr_read(sensor_cfg *cfg, void *args, int *const reading)
 {
 	CHECK_NULL_ARG_WITH_RETURN(cfg, false);
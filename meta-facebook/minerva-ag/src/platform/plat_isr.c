@@ -22,6 +22,7 @@
 #include "libipmi.h"
 #include "power_status.h"
 #include "sensor.h"
+#include "util_pmbus.h"
 
 #include "plat_gpio.h"
 #include "plat_i2c.h"
@@ -118,6 +119,9 @@ void ISR_GPIO_FM_PLD_UBC_EN_R()
 
 	LOG_INF("FM_PLD_UBC_EN_R = %d", gpio_get(FM_PLD_UBC_EN_R));
 
+	// VRs come back on their default PAGE after losing power
+	pmbus_page_cache_reset();
+
 	if (gpio_get(FM_PLD_UBC_EN_R) == GPIO_HIGH) {
 		plat_clock_init();
 		plat_set_dc_on_log(LOG_ASSERT);
@@ -24,6 +24,11 @@
 #define ENABLE_OEM_PLDM
 #define ENABLE_MCTP_I3C
 #define ENABLE_OCTEON
+#define ENABLE_PMBUS_PAGE_CACHE
+#define ENABLE_SENSOR_POLL_PAGE_GROUPING
+#define ENABLE_SENSOR_PARALLEL_POLL
+#define ENABLE_SENSOR_DEADLINE_POLL
+#define ENABLE_IPMB_MEM_POOL
 
 #define BMC_USB_PORT "CDC_ACM_0"
 
@@ -35,6 +35,7 @@
 #include "libutil.h"
 #include "xdpe15284.h"
 #include "util_sys.h"
+#include "util_pmbus.h"
 #include "plat_class.h"
 
 #include "i2c-mux-tca9548.h"
@@ -158,22 +159,29 @@ bool pre_isl69259_read(sensor_cfg *cfg, void *args)
 	CHECK_NULL_ARG_WITH_RETURN(args, false);
 
 	const isl69259_pre_proc_arg *pre_proc_args = (isl69259_pre_proc_arg *)args;
-	uint8_t retry = 5;
-	I2C_MSG msg;
-
-	/* set page */
-	msg.bus = cfg->port;
-	msg.target_addr = cfg->target_addr;
-	msg.tx_len = 2;
-	msg.data[0] = 0x00;
-	msg.data[1] = pre_proc_args->vr_page;
-	if (i2c_master_write(&msg, retry)) {
+
+	/* set page, skipped when the VR is already on it */
+	if (pmbus_select_page(cfg->port, cfg->target_addr, pre_proc_args->vr_page)) {
 		LOG_ERR("pre_isl69259_read, set page fail");
 		return false;
 	}
 	return true;
 }
 
+#ifdef ENABLE_SENSOR_POLL_PAGE_GROUPING
+uint8_t plat_get_sensor_poll_page(sensor_cfg *cfg)
+{
+	CHECK_NULL_ARG_WITH_RETURN(cfg, SENSOR_POLL_PAGE_NONE);
+
+	if ((cfg->pre_sensor_read_hook != pre_isl69259_read) ||
+	    (cfg->pre_sensor_read_args == NULL)) {
+		return SENSOR_POLL_PAGE_NONE;
+	}
+
+	return ((isl69259_pre_proc_arg *)cfg->pre_sensor_read_args)->vr_page;
+}
+#endif
+
 /* NVME pre read function
  *
  * set mux
@@ -22,6 +22,7 @@
 #define BMC_USB_PORT "CDC_ACM_0"
 
 #define ENABLE_APML
+#define ENABLE_IPMB_MEM_POOL
 
 #define WORKER_STACK_SIZE 4096
 
@@ -20,9 +20,11 @@
 #define ENABLE_PLDM
 #define ENABLE_MCTP_I3C
 #define ENABLE_PLDM_SENSOR
+#define ENABLE_PLDM_SENSOR_THRESHOLD_EVENT
 #define ENABLE_PLATFORM_PROVIDES_PLDM_SENSOR_STACKS
 #define ENABLE_APML
 #define ENABLE_EVENT_TO_BMC
+#define ENABLE_PLDM_FW_UPDATE_PIPELINE
 #define CONFIG_JTAG_HW_MODE
 
 #define DISABLE_ISL69259